@@ -0,0 +1,1011 @@
+/*
+
+vertext_bench.cpp
+
+    Runs the same workloads through vertext and through the quad generators that ship with
+    stb_truetype (and fontstash, if you have it) so we can see where vertext is ahead or behind.
+
+    For every font size and corpus (UI labels, log lines, a paragraph) it reports:
+        init ms         time to go from TTF bytes to a ready atlas (best of a few runs)
+        Mquads/s        glyph quads assembled per second, written out as x y u v triangles
+        atlas KB        bytes of the single channel atlas texture
+        out B/glyph     bytes the GPU receives per glyph (vertex buffer + index buffer if any)
+
+    Every generator writes the same thing the renderer would upload: six x y u v float vertices
+    per glyph (or four plus six indices for "vertext idx"). stb_truetype only hands out one
+    stbtt_aligned_quad at a time, so expanding that quad into vertices is part of its timing.
+
+BUILD:
+    c++ -O2 -I<dir with stb_truetype.h> bench/vertext_bench.cpp -o vertext_bench
+
+    With fontstash (https://github.com/memononen/fontstash). fontstash compiles its own copy of
+    stb_truetype, so it lives in its own translation unit:
+        cc  -O2 -c -I<dir with fontstash.h and stb_truetype.h> bench/vertext_bench_fontstash.c
+        c++ -O2 -DVTXT_BENCH_FONTSTASH -I<dir with stb_truetype.h> bench/vertext_bench.cpp \
+            vertext_bench_fontstash.o -o vertext_bench
+
+    Add -DVTXT_BUILTIN_RASTERIZER to bake with vertext's own rasterizer. The bench then also compares
+    it against stbtt_GetCodepointBitmap glyph by glyph (max and mean per pixel difference, pixels off
+    by more than BENCH_RASTER_TOLERANCE) and times both in glyphs per second. The bench exits with 1
+    if any glyph's bitmap box differs or any pixel is off by more than BENCH_RASTER_TOLERANCE.
+
+    Add -DVTXT_BENCH_PERF_COUNTERS (Linux only) to read hardware counters through perf_event_open
+    around every timed loop. Each row then also gets, per quad (per glyph when measuring): cycles,
+    instructions, IPC, L1D read misses, last level cache misses and branch misses; font init gets the
+    same per init. Counters that can't be opened (no PMU in a VM, perf_event_paranoid too high) print
+    as "-".
+
+    Vertext is also run on the paragraph corpus with every combination of the flags that change what
+    __private_vtxt_append_glyph does per glyph, to see which paths cost what. Each layout counts as a
+    frame, so with VTXT_TRACK_DAMAGE it ends with vtxt_grab_damage.
+
+    Measuring is timed on the paragraph corpus too, in glyphs per second: vtxt_get_text_bounding_box_info
+    on every line, and vtxt_append_line_centered and vtxt_append_line_align_right, which measure every
+    line before laying it out.
+
+    The atlas codec (vtxt_compress_atlas) is run on the bench font's atlas at every size: compressed
+    size against raw size, and how fast vtxt_decompress_next decodes it compared with a memcpy of the
+    raw atlas, both in GB/s of atlas written.
+
+    Then vertext writes the paragraph straight into a destination of ours (vtxt_set_vertex_output)
+    with regular stores and with VTXT_STREAMING_STORES, triangles and indexed. "cached" rewrites the
+    same 64 byte aligned window every layout, so it stays in the cache. "cold" moves on to the next
+    window of a BENCH_COLD_BYTES buffer every layout, so every line written was evicted long ago.
+    That stands in for a write-combined (mapped GPU) buffer, which a user mode bench can't allocate:
+    regular stores have to read each line in before writing it there, streaming stores don't.
+
+RUN:
+    ./vertext_bench path/to/font.ttf [size_px ...]        (default sizes: 14 24 48)
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#ifdef VTXT_BENCH_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+#define BENCH_MAX_CHARS 16384
+#define VTXT_MAX_CHAR_IN_BUFFER BENCH_MAX_CHARS
+#define VERTEXT_IMPLEMENTATION
+#include "../vertext.h"
+
+#ifdef VTXT_BENCH_FONTSTASH
+extern "C"
+{
+    int bench_fontstash_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out);
+    int bench_fontstash_layout(const char* const* lines, int line_count, int text_height_px, float* out);
+    void bench_fontstash_shutdown();
+}
+#endif
+
+#define BENCH_MIN_SECONDS 0.25
+#define BENCH_INIT_RUNS 5
+#define BENCH_FIRST_CHAR 32
+#define BENCH_CHAR_COUNT 95
+
+static const char* corpus_ui_labels[] = {
+    "OK", "Cancel", "Apply", "File", "Edit", "View", "Window", "Help", "Settings",
+    "Volume", "Fullscreen", "Resolution: 1920x1080", "V-Sync", "Back", "Quit to Desktop",
+    "Health 100/100", "Ammo 30", "Score: 123456", "Level 7", "Press [E] to interact",
+};
+
+static const char* corpus_log_lines[] = {
+    "[12:00:01.332] INFO  renderer: created swapchain 1920x1080 format=BGRA8 vsync=1",
+    "[12:00:01.347] INFO  assets: loaded 412 textures (183.4 MB) in 912 ms",
+    "[12:00:01.351] WARN  audio: device sample rate 44100 differs from requested 48000",
+    "[12:00:02.004] DEBUG net: connect 192.168.1.20:27015 attempt=1 timeout=5000ms",
+    "[12:00:02.118] INFO  net: connected, rtt=14ms, tick=64, protocol v23",
+    "[12:00:02.590] ERROR script: ui/hud.lua:118: attempt to index nil value 'player'",
+    "[12:00:03.771] INFO  world: streamed chunk (12, -4) 2048 entities, 96 lights",
+    "[12:00:04.002] DEBUG physics: step 4.21 ms, 1532 contacts, 88 islands, 3 sleeping",
+};
+
+static const char* corpus_paragraph[] = {
+    "It was a bright cold day in April, and the clocks were striking thirteen. Winston",
+    "Smith, his chin nuzzled into his breast in an effort to escape the vile wind,",
+    "slipped quickly through the glass doors of Victory Mansions, though not quickly",
+    "enough to prevent a swirl of gritty dust from entering along with him. The hallway",
+    "smelt of boiled cabbage and old rag mats. At one end of it a coloured poster, too",
+    "large for indoor display, had been tacked to the wall. It depicted simply an",
+    "enormous face, more than a metre wide: the face of a man of about forty-five, with",
+    "a heavy black moustache and ruggedly handsome features.",
+};
+
+typedef struct bench_corpus
+{
+    const char*         name;
+    const char* const*  lines;
+    int                 line_count;
+} bench_corpus;
+
+#define BENCH_CORPUS(name, lines) { name, lines, (int)(sizeof(lines) / sizeof(lines[0])) }
+static const bench_corpus corpora[] = {
+    BENCH_CORPUS("ui labels", corpus_ui_labels),
+    BENCH_CORPUS("log lines", corpus_log_lines),
+    BENCH_CORPUS("paragraph", corpus_paragraph),
+};
+#define BENCH_CORPUS_COUNT (int)(sizeof(corpora) / sizeof(corpora[0]))
+
+enum
+{
+    BENCH_CYCLES,
+    BENCH_INSTRUCTIONS,
+    BENCH_L1D_MISSES,
+    BENCH_LLC_MISSES,
+    BENCH_BRANCH_MISSES,
+    BENCH_COUNTER_COUNT
+};
+
+/** Hardware counter totals over one timed loop, -1 for counters that are not available. */
+typedef struct bench_counters
+{
+    double  values[BENCH_COUNTER_COUNT];
+} bench_counters;
+
+/** Result of one generator on one corpus at one size. */
+typedef struct bench_result
+{
+    double          init_ms;
+    double          quads_per_sec;
+    int             atlas_bytes;
+    double          output_bytes_per_glyph;
+    bench_counters  init_counters;      // summed over BENCH_INIT_RUNS inits
+    int             init_runs;
+    bench_counters  layout_counters;    // summed over the timed layouts
+    long long       layout_quads;
+} bench_result;
+
+/** Interface every generator implements. layout writes quads for the whole corpus to out and
+    returns the number of quads. output_bytes reports how many bytes the last layout produced. */
+typedef struct bench_generator
+{
+    const char* name;
+    int         (*init)(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out);
+    int         (*layout)(const bench_corpus* corpus, int text_height_px, float* out);
+    size_t      (*output_bytes)(int quad_count);
+    void        (*shutdown)();
+} bench_generator;
+
+static double bench_seconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef VTXT_BENCH_PERF_COUNTERS
+static int bench_counter_fds[BENCH_COUNTER_COUNT];
+
+/** Opens one counter per event, each multiplexed on its own so that a PMU with few counters still
+    gives (scaled) numbers for all of them. Counts user space of this thread only. */
+static void bench_counters_open()
+{
+    static const unsigned int types[BENCH_COUNTER_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+    };
+    static const unsigned long long configs[BENCH_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        bench_counter_fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+}
+
+static void bench_counters_close()
+{
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        if(bench_counter_fds[i] >= 0)
+        {
+            close(bench_counter_fds[i]);
+        }
+    }
+}
+
+static void bench_counters_start()
+{
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        if(bench_counter_fds[i] >= 0)
+        {
+            ioctl(bench_counter_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(bench_counter_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+/** Stops the counters and adds what they counted since bench_counters_start to counters. */
+static void bench_counters_stop(bench_counters* counters)
+{
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        unsigned long long value[3]; // count, time enabled, time running
+        if(bench_counter_fds[i] < 0)
+        {
+            continue;
+        }
+        ioctl(bench_counter_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        if(read(bench_counter_fds[i], value, sizeof(value)) != (ssize_t)sizeof(value) || value[2] == 0)
+        {
+            continue;
+        }
+        // Scale up for the time the counter was multiplexed out
+        double count = (double)value[0] * ((double)value[1] / (double)value[2]);
+        counters->values[i] = counters->values[i] < 0.0 ? count : counters->values[i] + count;
+    }
+}
+#else
+static void bench_counters_open()
+{
+}
+
+static void bench_counters_close()
+{
+}
+
+static void bench_counters_start()
+{
+}
+
+static void bench_counters_stop(bench_counters* counters)
+{
+    (void)counters;
+}
+#endif
+
+static void bench_counters_clear(bench_counters* counters)
+{
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        counters->values[i] = -1.0;
+    }
+}
+
+/** Prints counters divided by per (quads, inits) as extra table columns, nothing without VTXT_BENCH_PERF_COUNTERS. */
+static void bench_print_counters(const bench_counters* counters, double per)
+{
+#ifdef VTXT_BENCH_PERF_COUNTERS
+    const double* v = counters->values;
+    for(int i = 0; i < BENCH_COUNTER_COUNT; ++i)
+    {
+        if(i == BENCH_L1D_MISSES)
+        {
+            // IPC goes right after instructions
+            if(v[BENCH_CYCLES] > 0.0 && v[BENCH_INSTRUCTIONS] >= 0.0)
+            {
+                printf(" %6.2f", v[BENCH_INSTRUCTIONS] / v[BENCH_CYCLES]);
+            }
+            else
+            {
+                printf(" %6s", "-");
+            }
+        }
+        if(v[i] >= 0.0 && per > 0.0)
+        {
+            printf(" %9.2f", v[i] / per);
+        }
+        else
+        {
+            printf(" %9s", "-");
+        }
+    }
+#else
+    (void)counters;
+    (void)per;
+#endif
+}
+
+static void bench_print_counter_header()
+{
+#ifdef VTXT_BENCH_PERF_COUNTERS
+    printf(" %9s %9s %6s %9s %9s %9s", "cyc/quad", "ins/quad", "IPC", "L1D/quad", "LLC/quad", "brm/quad");
+#endif
+}
+
+/** Writes a stb_truetype quad as two triangles in the same corner order vertext uses. */
+static float* bench_write_quad(float* out, const stbtt_aligned_quad* q)
+{
+    const float v[6][4] = {
+        { q->x0, q->y1, q->s0, q->t1 }, { q->x1, q->y0, q->s1, q->t0 }, { q->x0, q->y0, q->s0, q->t0 },
+        { q->x1, q->y1, q->s1, q->t1 }, { q->x1, q->y0, q->s1, q->t0 }, { q->x0, q->y1, q->s0, q->t1 },
+    };
+    memcpy(out, v, sizeof(v));
+    return out + 24;
+}
+
+static size_t bench_six_vertices_per_quad(int quad_count)
+{
+    return (size_t)quad_count * 6 * 4 * sizeof(float);
+}
+
+
+// vertext
+static vtxt_font bench_vtxt_font;
+
+static int bench_vtxt_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out)
+{
+    vtxt_init_font_ex(&bench_vtxt_font, ttf, (size_t)ttf_size, text_height_px);
+    *atlas_bytes_out = bench_vtxt_font.font_atlas.width * bench_vtxt_font.font_atlas.height;
+    return 1;
+}
+
+static int bench_vtxt_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    (void)out; // vertext writes into its own buffer, which is what a caller would upload
+    vtxt_clear_buffer();
+    vtxt_move_cursor(0, text_height_px);
+    for(int i = 0; i < corpus->line_count; ++i)
+    {
+        vtxt_append_line(corpus->lines[i], &bench_vtxt_font, text_height_px);
+        vtxt_new_line(0, &bench_vtxt_font, text_height_px);
+    }
+    vtxt_vertex_buffer vb = vtxt_grab_buffer();
+    return (vb.indices_array_count > 0 ? vb.indices_array_count : vb.vertex_count) / 6;
+}
+
+static size_t bench_vtxt_output_bytes(int quad_count)
+{
+    (void)quad_count;
+    vtxt_vertex_buffer vb = vtxt_grab_buffer();
+    return (size_t)vb.vertices_array_count * sizeof(float) + (size_t)vb.indices_array_count * sizeof(unsigned int);
+}
+
+static int bench_vtxt_indexed_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out)
+{
+    vtxt_setflags(VTXT_CREATE_INDEX_BUFFER);
+    return bench_vtxt_init(ttf, ttf_size, text_height_px, atlas_bytes_out);
+}
+
+static void bench_vtxt_shutdown()
+{
+    free(bench_vtxt_font.font_atlas.pixels);
+    vtxt_setflags(0);
+    vtxt_clear_buffer();
+}
+
+
+// stb_truetype: stbtt_BakeFontBitmap + stbtt_GetBakedQuad
+static stbtt_bakedchar bench_baked_chars[BENCH_CHAR_COUNT];
+static unsigned char* bench_baked_pixels;
+static int bench_baked_size;
+
+static int bench_baked_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out)
+{
+    (void)ttf_size;
+    // Smallest power of two square that fits, which is what you'd ship
+    for(bench_baked_size = 64; bench_baked_size <= 4096; bench_baked_size *= 2)
+    {
+        bench_baked_pixels = (unsigned char*)malloc((size_t)bench_baked_size * bench_baked_size);
+        if(stbtt_BakeFontBitmap(ttf, 0, (float)text_height_px, bench_baked_pixels, bench_baked_size, bench_baked_size,
+                                BENCH_FIRST_CHAR, BENCH_CHAR_COUNT, bench_baked_chars) > 0)
+        {
+            *atlas_bytes_out = bench_baked_size * bench_baked_size;
+            return 1;
+        }
+        free(bench_baked_pixels);
+    }
+    bench_baked_pixels = NULL;
+    return 0;
+}
+
+static int bench_baked_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    int quad_count = 0;
+    float y = (float)text_height_px;
+    for(int i = 0; i < corpus->line_count; ++i, y += (float)text_height_px)
+    {
+        float x = 0.f;
+        float line_y = y;
+        for(const char* c = corpus->lines[i]; *c != '\0'; ++c)
+        {
+            if(*c < BENCH_FIRST_CHAR || *c >= BENCH_FIRST_CHAR + BENCH_CHAR_COUNT)
+            {
+                continue;
+            }
+            stbtt_aligned_quad q;
+            stbtt_GetBakedQuad(bench_baked_chars, bench_baked_size, bench_baked_size, *c - BENCH_FIRST_CHAR, &x, &line_y, &q, 1);
+            out = bench_write_quad(out, &q);
+            ++quad_count;
+        }
+    }
+    return quad_count;
+}
+
+static void bench_baked_shutdown()
+{
+    free(bench_baked_pixels);
+    bench_baked_pixels = NULL;
+}
+
+
+// stb_truetype: stbtt_PackFontRanges + stbtt_GetPackedQuad
+static stbtt_packedchar bench_packed_chars[BENCH_CHAR_COUNT];
+static unsigned char* bench_packed_pixels;
+static int bench_packed_size;
+
+static int bench_packed_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out)
+{
+    (void)ttf_size;
+    for(bench_packed_size = 64; bench_packed_size <= 4096; bench_packed_size *= 2)
+    {
+        bench_packed_pixels = (unsigned char*)malloc((size_t)bench_packed_size * bench_packed_size);
+        stbtt_pack_context pc;
+        stbtt_pack_range range;
+        memset(&range, 0, sizeof(range));
+        range.font_size = (float)text_height_px;
+        range.first_unicode_codepoint_in_range = BENCH_FIRST_CHAR;
+        range.num_chars = BENCH_CHAR_COUNT;
+        range.chardata_for_range = bench_packed_chars;
+        int packed = 0;
+        if(stbtt_PackBegin(&pc, bench_packed_pixels, bench_packed_size, bench_packed_size, 0, 1, NULL))
+        {
+            stbtt_PackSetOversampling(&pc, 1, 1);
+            packed = stbtt_PackFontRanges(&pc, ttf, 0, &range, 1);
+            stbtt_PackEnd(&pc);
+        }
+        if(packed)
+        {
+            *atlas_bytes_out = bench_packed_size * bench_packed_size;
+            return 1;
+        }
+        free(bench_packed_pixels);
+    }
+    bench_packed_pixels = NULL;
+    return 0;
+}
+
+static int bench_packed_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    int quad_count = 0;
+    float y = (float)text_height_px;
+    for(int i = 0; i < corpus->line_count; ++i, y += (float)text_height_px)
+    {
+        float x = 0.f;
+        float line_y = y;
+        for(const char* c = corpus->lines[i]; *c != '\0'; ++c)
+        {
+            if(*c < BENCH_FIRST_CHAR || *c >= BENCH_FIRST_CHAR + BENCH_CHAR_COUNT)
+            {
+                continue;
+            }
+            stbtt_aligned_quad q;
+            stbtt_GetPackedQuad(bench_packed_chars, bench_packed_size, bench_packed_size, *c - BENCH_FIRST_CHAR, &x, &line_y, &q, 1);
+            out = bench_write_quad(out, &q);
+            ++quad_count;
+        }
+    }
+    return quad_count;
+}
+
+static void bench_packed_shutdown()
+{
+    free(bench_packed_pixels);
+    bench_packed_pixels = NULL;
+}
+
+
+#ifdef VTXT_BENCH_FONTSTASH
+// fontstash (vertext_bench_fontstash.c)
+static int bench_fons_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    return bench_fontstash_layout(corpus->lines, corpus->line_count, text_height_px, out);
+}
+#endif
+
+static const bench_generator generators[] = {
+    { "vertext",        bench_vtxt_init,         bench_vtxt_layout,   bench_vtxt_output_bytes,     bench_vtxt_shutdown },
+    { "vertext idx",    bench_vtxt_indexed_init, bench_vtxt_layout,   bench_vtxt_output_bytes,     bench_vtxt_shutdown },
+    { "stbtt baked",    bench_baked_init,        bench_baked_layout,  bench_six_vertices_per_quad, bench_baked_shutdown },
+    { "stbtt packed",   bench_packed_init,       bench_packed_layout, bench_six_vertices_per_quad, bench_packed_shutdown },
+#ifdef VTXT_BENCH_FONTSTASH
+    { "fontstash",      bench_fontstash_init,    bench_fons_layout,   bench_six_vertices_per_quad, bench_fontstash_shutdown },
+#endif
+};
+#define BENCH_GENERATOR_COUNT (int)(sizeof(generators) / sizeof(generators[0]))
+
+static float bench_out[BENCH_MAX_CHARS * 6 * 4];
+
+/** Runs layout over and over for at least BENCH_MIN_SECONDS, counting hardware events into counters.
+    Returns quads per second and the total number of quads in quads_out. */
+static double bench_layout_rate(int (*layout)(const bench_corpus*, int, float*), const bench_corpus* corpus,
+                                int text_height_px, bench_counters* counters, long long* quads_out)
+{
+    layout(corpus, text_height_px, bench_out); // warm up
+    long long quads = 0;
+    double start = bench_seconds();
+    double elapsed = 0.0;
+    bench_counters_start();
+    do
+    {
+        for(int i = 0; i < 64; ++i)
+        {
+            quads += layout(corpus, text_height_px, bench_out);
+        }
+        elapsed = bench_seconds() - start;
+    } while(elapsed < BENCH_MIN_SECONDS);
+    bench_counters_stop(counters);
+    *quads_out = quads;
+    return (double)quads / elapsed;
+}
+
+static int bench_run(const bench_generator* gen, unsigned char* ttf, int ttf_size, int text_height_px,
+                     const bench_corpus* corpus, bench_result* result)
+{
+    result->init_ms = 1e30;
+    result->init_runs = BENCH_INIT_RUNS;
+    bench_counters_clear(&result->init_counters);
+    bench_counters_clear(&result->layout_counters);
+    for(int run = 0; run < BENCH_INIT_RUNS; ++run)
+    {
+        double start = bench_seconds();
+        bench_counters_start();
+        int initialized = gen->init(ttf, ttf_size, text_height_px, &result->atlas_bytes);
+        bench_counters_stop(&result->init_counters);
+        if(!initialized)
+        {
+            return 0;
+        }
+        double ms = (bench_seconds() - start) * 1000.0;
+        result->init_ms = ms < result->init_ms ? ms : result->init_ms;
+        if(run + 1 < BENCH_INIT_RUNS)
+        {
+            gen->shutdown();
+        }
+    }
+
+    result->quads_per_sec = bench_layout_rate(gen->layout, corpus, text_height_px, &result->layout_counters,
+                                              &result->layout_quads);
+    int quads_per_layout = gen->layout(corpus, text_height_px, bench_out);
+    result->output_bytes_per_glyph = quads_per_layout > 0
+        ? (double)gen->output_bytes(quads_per_layout) / (double)quads_per_layout : 0.0;
+    gen->shutdown();
+    return 1;
+}
+
+/** Flags that change the work __private_vtxt_append_glyph does per glyph. */
+static const struct
+{
+    int         flag;
+    const char* name;
+} bench_glyph_flags[] = {
+    { VTXT_CREATE_INDEX_BUFFER,  "idx" },
+    { VTXT_USE_CLIPSPACE_COORDS, "clip" },
+    { VTXT_FLIP_Y,               "flipy" },
+    { VTXT_CREATE_COLOR_BUFFER,  "color" },
+    { VTXT_TRACK_DAMAGE,         "damage" },
+};
+#define BENCH_GLYPH_FLAG_COUNT (int)(sizeof(bench_glyph_flags) / sizeof(bench_glyph_flags[0]))
+
+static int bench_track_damage;   // VTXT_TRACK_DAMAGE is in the flags being timed
+
+/** bench_vtxt_layout as one frame: with VTXT_TRACK_DAMAGE the frame ends with vtxt_grab_damage, so every
+    frame hashes its blocks instead of piling them up past VTXT_MAX_DAMAGE_BLOCKS into the overflow rect. */
+static int bench_vtxt_frame_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    int quads = bench_vtxt_layout(corpus, text_height_px, out);
+    if(bench_track_damage)
+    {
+        vtxt_rect damage[4];
+        vtxt_grab_damage(damage, 4);
+    }
+    return quads;
+}
+
+/** Times vertext on the paragraph corpus with every combination of bench_glyph_flags. */
+static void bench_glyph_flag_combinations(unsigned char* ttf, int ttf_size, int text_height_px)
+{
+    int atlas_bytes;
+    bench_vtxt_init(ttf, ttf_size, text_height_px, &atlas_bytes);
+    const bench_corpus* corpus = &corpora[BENCH_CORPUS_COUNT - 1];
+    for(int combination = 0; combination < (1 << BENCH_GLYPH_FLAG_COUNT); ++combination)
+    {
+        int flags = 0;
+        char name[64] = "";
+        for(int f = 0; f < BENCH_GLYPH_FLAG_COUNT; ++f)
+        {
+            if(combination & (1 << f))
+            {
+                flags |= bench_glyph_flags[f].flag;
+                strcat(name, name[0] ? "|" : "");
+                strcat(name, bench_glyph_flags[f].name);
+            }
+        }
+        vtxt_setflags(flags);
+        vtxt_clear_buffer();
+        bench_track_damage = (flags & VTXT_TRACK_DAMAGE) != 0;
+        bench_counters counters;
+        bench_counters_clear(&counters);
+        long long quads;
+        double quads_per_sec = bench_layout_rate(bench_vtxt_frame_layout, corpus, text_height_px, &counters, &quads);
+        printf("%-6d %-28s %10.2f", text_height_px, name[0] ? name : "none", quads_per_sec / 1e6);
+        bench_print_counters(&counters, (double)quads);
+        printf("\n");
+    }
+    bench_vtxt_shutdown();
+}
+
+enum
+{
+    BENCH_MEASURE_BOUNDING_BOX,
+    BENCH_MEASURE_CENTERED,
+    BENCH_MEASURE_ALIGN_RIGHT,
+    BENCH_MEASURE_COUNT
+};
+static const char* bench_measure_names[BENCH_MEASURE_COUNT] = { "bounding box", "centered", "align right" };
+static int bench_measure;               // which of the above bench_vtxt_measure runs
+static volatile float bench_measure_sink; // keeps the bounding boxes from being optimized away
+
+/** Measures (and for centered and right-aligned text, lays out) every line of corpus. Returns the glyphs
+    measured, so bounding boxes and appends are rated by the same count. */
+static int bench_vtxt_measure(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    (void)out;
+    int glyphs = 0;
+    vtxt_clear_buffer();
+    for(int i = 0; i < corpus->line_count; ++i)
+    {
+        const char* line = corpus->lines[i];
+        if(bench_measure == BENCH_MEASURE_BOUNDING_BOX)
+        {
+            float width, height;
+            vtxt_get_text_bounding_box_info(&width, &height, line, &bench_vtxt_font, text_height_px);
+            bench_measure_sink = width + height;
+        }
+        else
+        {
+            vtxt_move_cursor(bench_measure == BENCH_MEASURE_CENTERED ? 400 : 800, (i + 1) * text_height_px);
+            if(bench_measure == BENCH_MEASURE_CENTERED)
+            {
+                vtxt_append_line_centered(line, &bench_vtxt_font, text_height_px);
+            }
+            else
+            {
+                vtxt_append_line_align_right(line, &bench_vtxt_font, text_height_px);
+            }
+        }
+        glyphs += (int)strlen(line);
+    }
+    return glyphs;
+}
+
+/** Times measuring the paragraph corpus, see bench_vtxt_measure. */
+static void bench_measuring(unsigned char* ttf, int ttf_size, int text_height_px)
+{
+    int atlas_bytes;
+    bench_vtxt_init(ttf, ttf_size, text_height_px, &atlas_bytes);
+    const bench_corpus* corpus = &corpora[BENCH_CORPUS_COUNT - 1];
+    vtxt_setflags(0);
+    for(bench_measure = 0; bench_measure < BENCH_MEASURE_COUNT; ++bench_measure)
+    {
+        bench_counters counters;
+        bench_counters_clear(&counters);
+        long long glyphs;
+        double glyphs_per_sec = bench_layout_rate(bench_vtxt_measure, corpus, text_height_px, &counters, &glyphs);
+        printf("%-6d %-28s %10.2f", text_height_px, bench_measure_names[bench_measure], glyphs_per_sec / 1e6);
+        bench_print_counters(&counters, (double)glyphs);
+        printf("\n");
+    }
+    bench_vtxt_shutdown();
+}
+
+/** Compresses the atlas of the bench font with vtxt_compress_atlas and times decoding it with
+    vtxt_decompress_next against a memcpy of the raw atlas. */
+static void bench_atlas_compression(unsigned char* ttf, int ttf_size, int text_height_px)
+{
+    int atlas_bytes;
+    bench_vtxt_init(ttf, ttf_size, text_height_px, &atlas_bytes);
+    const unsigned char* raw = bench_vtxt_font.font_atlas.pixels;
+    size_t raw_size = (size_t)atlas_bytes;
+    unsigned char* compressed = (unsigned char*)malloc(vtxt_compress_bound(raw_size));
+    size_t compressed_size = vtxt_compress_atlas(raw, raw_size, compressed, vtxt_compress_bound(raw_size));
+    unsigned char* decoded = (unsigned char*)malloc(raw_size);
+
+    double bytes_per_sec[2];
+    for(int decode = 0; decode < 2; ++decode)
+    {
+        long long bytes = 0;
+        double start = bench_seconds();
+        double elapsed = 0.0;
+        do
+        {
+            for(int i = 0; i < 16; ++i)
+            {
+                if(decode)
+                {
+                    vtxt_decompress_stream stream;
+                    vtxt_decompress_begin(&stream, compressed, compressed_size);
+                    bytes += (long long)vtxt_decompress_next(&stream, decoded, raw_size);
+                }
+                else
+                {
+                    memcpy(decoded, raw, raw_size);
+                    bytes += (long long)raw_size;
+                }
+            }
+            elapsed = bench_seconds() - start;
+        } while(elapsed < BENCH_MIN_SECONDS);
+        bytes_per_sec[decode] = (double)bytes / elapsed;
+    }
+    int matches = memcmp(decoded, raw, raw_size) == 0;
+
+    printf("%-6d %10.1f %10.1f %8.1fx %12.2f %12.2f%s\n", text_height_px, raw_size / 1024.0, compressed_size / 1024.0,
+           compressed_size > 0 ? (double)raw_size / (double)compressed_size : 0.0, bytes_per_sec[0] / 1e9,
+           bytes_per_sec[1] / 1e9, matches ? "" : "   (decoded atlas differs)");
+    free(decoded);
+    free(compressed);
+    bench_vtxt_shutdown();
+}
+
+#define BENCH_COLD_BYTES ((size_t)256 << 20)   // well past any last level cache
+
+static unsigned char* bench_store_memory;      // 64 byte aligned
+static size_t bench_store_span;                // bytes the layouts cycle through
+static size_t bench_store_offset;              // where the next layout writes
+
+/** bench_vtxt_layout into the next window of bench_store_memory. */
+static int bench_vtxt_store_layout(const bench_corpus* corpus, int text_height_px, float* out)
+{
+    const size_t window = (size_t)BENCH_MAX_CHARS * 6 * 16;
+    if(bench_store_offset + window > bench_store_span)
+    {
+        bench_store_offset = 0;
+    }
+    vtxt_vertex_layout layout = { 16, { 0, VTXT_FORMAT_FLOAT32x2 }, { 8, VTXT_FORMAT_FLOAT32x2 }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE } };
+    vtxt_set_vertex_output(bench_store_memory + bench_store_offset, BENCH_MAX_CHARS * 6, &layout);
+    int quads = bench_vtxt_layout(corpus, text_height_px, out);
+    if(bench_store_span > window)
+    {
+        bench_store_offset += ((size_t)vtxt_grab_buffer().vertex_count * 16 + 63) & ~(size_t)63;
+    }
+    return quads;
+}
+
+/** Times vertext on the paragraph corpus writing into a cached and a cold destination, with regular
+    and with streaming stores. */
+static void bench_store_modes(unsigned char* ttf, int ttf_size, int text_height_px)
+{
+    int atlas_bytes;
+    bench_vtxt_init(ttf, ttf_size, text_height_px, &atlas_bytes);
+    const bench_corpus* corpus = &corpora[BENCH_CORPUS_COUNT - 1];
+    unsigned char* memory = (unsigned char*)malloc(BENCH_COLD_BYTES + 64);
+    memset(memory, 0, BENCH_COLD_BYTES + 64); // fault the pages in before timing
+    bench_store_memory = memory + (64 - (size_t)memory % 64);
+    for(int cold = 0; cold < 2; ++cold)
+    {
+        for(int indexed = 0; indexed < 2; ++indexed)
+        {
+            for(int streaming = 0; streaming < 2; ++streaming)
+            {
+                vtxt_setflags((indexed ? VTXT_CREATE_INDEX_BUFFER : 0) | (streaming ? VTXT_STREAMING_STORES : 0));
+                bench_store_span = cold ? BENCH_COLD_BYTES : (size_t)BENCH_MAX_CHARS * 6 * 16;
+                bench_store_offset = 0;
+                bench_counters counters;
+                bench_counters_clear(&counters);
+                long long quads;
+                double quads_per_sec = bench_layout_rate(bench_vtxt_store_layout, corpus, text_height_px, &counters, &quads);
+                printf("%-6d %-8s %-5s %-10s %10.2f", text_height_px, cold ? "cold" : "cached", indexed ? "idx" : "tris",
+                       streaming ? "streaming" : "regular", quads_per_sec / 1e6);
+                bench_print_counters(&counters, (double)quads);
+                printf("\n");
+            }
+        }
+    }
+    vtxt_set_vertex_output(NULL, 0, NULL);
+    free(memory);
+    bench_vtxt_shutdown();
+}
+
+#ifdef VTXT_BUILTIN_RASTERIZER
+#define BENCH_RASTER_TOLERANCE 16   // per pixel difference (out of 255) counted as a mismatch
+
+/** Rasterizes the ASCII range with stbtt_GetCodepointBitmap and with vertext's built-in rasterizer,
+    compares the two bitmaps pixel by pixel and times both in glyphs per second. Returns 0 if any glyph's
+    bitmap box differs or any pixel differs by more than BENCH_RASTER_TOLERANCE, else 1. */
+static int bench_rasterizers(unsigned char* ttf, int text_height_px)
+{
+    stbtt_fontinfo info;
+    stbtt_InitFont(&info, ttf, 0);
+    float scale = stbtt_ScaleForMappingEmToPixels(&info, (float)text_height_px);
+
+    int max_diff = 0;
+    long long diff_sum = 0;
+    long long pixel_count = 0;
+    long long mismatch_count = 0;
+    int box_mismatch_count = 0;
+    for(int c = BENCH_FIRST_CHAR; c < BENCH_FIRST_CHAR + BENCH_CHAR_COUNT; ++c)
+    {
+        int w0, h0, x0, y0, w1, h1, x1, y1;
+        unsigned char* reference = stbtt_GetCodepointBitmap(&info, 0, scale, c, &w0, &h0, &x0, &y0);
+        unsigned char* builtin = __private_vtxt_rasterize_codepoint(&info, scale, c, &w1, &h1, &x1, &y1);
+        if(w0 != w1 || h0 != h1 || x0 != x1 || y0 != y1)
+        {
+            printf("raster %-4d glyph '%c' bitmap box differs: stbtt %dx%d at %d,%d builtin %dx%d at %d,%d\n",
+                   text_height_px, (char)c, w0, h0, x0, y0, w1, h1, x1, y1);
+            ++box_mismatch_count;
+        }
+        else
+        {
+            for(int i = 0; i < w0 * h0; ++i)
+            {
+                int diff = abs((int)reference[i] - (int)builtin[i]);
+                max_diff = diff > max_diff ? diff : max_diff;
+                diff_sum += diff;
+                mismatch_count += diff > BENCH_RASTER_TOLERANCE;
+            }
+            pixel_count += w0 * h0;
+        }
+        stbtt_FreeBitmap(reference, 0);
+        free(builtin);
+    }
+
+    double glyphs_per_sec[2];
+    for(int r = 0; r < 2; ++r)
+    {
+        long long glyphs = 0;
+        double start = bench_seconds();
+        double elapsed = 0.0;
+        do
+        {
+            for(int c = BENCH_FIRST_CHAR; c < BENCH_FIRST_CHAR + BENCH_CHAR_COUNT; ++c)
+            {
+                int w, h, x, y;
+                if(r == 0)
+                {
+                    stbtt_FreeBitmap(stbtt_GetCodepointBitmap(&info, 0, scale, c, &w, &h, &x, &y), 0);
+                }
+                else
+                {
+                    free(__private_vtxt_rasterize_codepoint(&info, scale, c, &w, &h, &x, &y));
+                }
+            }
+            glyphs += BENCH_CHAR_COUNT;
+            elapsed = bench_seconds() - start;
+        } while(elapsed < BENCH_MIN_SECONDS);
+        glyphs_per_sec[r] = (double)glyphs / elapsed;
+    }
+
+    printf("%-6d %14.0f %14.0f %10d %10.3f %12lld\n", text_height_px, glyphs_per_sec[0], glyphs_per_sec[1],
+           max_diff, pixel_count ? (double)diff_sum / (double)pixel_count : 0.0, mismatch_count);
+    return box_mismatch_count == 0 && max_diff <= BENCH_RASTER_TOLERANCE;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s font.ttf [size_px ...]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if(!file)
+    {
+        fprintf(stderr, "could not open %s\n", argv[1]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    int ttf_size = (int)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* ttf = (unsigned char*)malloc(ttf_size);
+    if(fread(ttf, 1, ttf_size, file) != (size_t)ttf_size)
+    {
+        fprintf(stderr, "could not read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(file);
+
+    int default_sizes[] = { 14, 24, 48 };
+    int size_count = argc > 2 ? argc - 2 : 3;
+
+    bench_counters_open();
+    static bench_result init_results[BENCH_GENERATOR_COUNT];
+    printf("%-6s %-10s %-13s %10s %10s %10s %12s", "size", "corpus", "generator", "init ms", "Mquads/s", "atlas KB", "out B/glyph");
+    bench_print_counter_header();
+    printf("\n");
+    for(int s = 0; s < size_count; ++s)
+    {
+        int text_height_px = argc > 2 ? atoi(argv[2 + s]) : default_sizes[s];
+        memset(init_results, 0, sizeof(init_results));
+        for(int c = 0; c < BENCH_CORPUS_COUNT; ++c)
+        {
+            for(int g = 0; g < BENCH_GENERATOR_COUNT; ++g)
+            {
+                bench_result r;
+                if(!bench_run(&generators[g], ttf, ttf_size, text_height_px, &corpora[c], &r))
+                {
+                    printf("%-6d %-10s %-13s %10s\n", text_height_px, corpora[c].name, generators[g].name, "failed");
+                    continue;
+                }
+                printf("%-6d %-10s %-13s %10.3f %10.2f %10.1f %12.1f", text_height_px, corpora[c].name, generators[g].name,
+                       r.init_ms, r.quads_per_sec / 1e6, r.atlas_bytes / 1024.0, r.output_bytes_per_glyph);
+                bench_print_counters(&r.layout_counters, (double)r.layout_quads);
+                printf("\n");
+                if(c == 0)
+                {
+                    init_results[g] = r;
+                }
+            }
+        }
+#ifdef VTXT_BENCH_PERF_COUNTERS
+        // Init doesn't depend on the corpus, so one row per generator
+        for(int g = 0; g < BENCH_GENERATOR_COUNT; ++g)
+        {
+            printf("%-6d %-10s %-13s %10.3f", text_height_px, "font init", generators[g].name, init_results[g].init_ms);
+            printf("%*s", 35, "");
+            bench_print_counters(&init_results[g].init_counters, 1000.0 * init_results[g].init_runs);
+            printf("   (thousands per init)\n");
+        }
+#endif
+    }
+
+    printf("\n%-6s %-28s %10s", "size", "vertext flags (paragraph)", "Mquads/s");
+    bench_print_counter_header();
+    printf("\n");
+    for(int s = 0; s < size_count; ++s)
+    {
+        bench_glyph_flag_combinations(ttf, ttf_size, argc > 2 ? atoi(argv[2 + s]) : default_sizes[s]);
+    }
+
+    printf("\n%-6s %-28s %10s", "size", "vertext measure (paragraph)", "Mglyphs/s");
+    bench_print_counter_header();
+    printf("\n");
+    for(int s = 0; s < size_count; ++s)
+    {
+        bench_measuring(ttf, ttf_size, argc > 2 ? atoi(argv[2 + s]) : default_sizes[s]);
+    }
+
+    printf("\n%-6s %10s %10s %9s %12s %12s\n", "size", "atlas KB", "packed KB", "ratio", "memcpy GB/s", "decode GB/s");
+    for(int s = 0; s < size_count; ++s)
+    {
+        bench_atlas_compression(ttf, ttf_size, argc > 2 ? atoi(argv[2 + s]) : default_sizes[s]);
+    }
+
+    printf("\n%-6s %-8s %-5s %-10s %10s", "size", "dest", "quads", "stores", "Mquads/s");
+    bench_print_counter_header();
+    printf("\n");
+    for(int s = 0; s < size_count; ++s)
+    {
+        bench_store_modes(ttf, ttf_size, argc > 2 ? atoi(argv[2 + s]) : default_sizes[s]);
+    }
+    bench_counters_close();
+
+#ifdef VTXT_BUILTIN_RASTERIZER
+    int rasterizers_match = 1;
+    printf("\n%-6s %14s %14s %10s %10s %12s\n", "size", "stbtt glyph/s", "vtxt glyph/s", "max diff", "mean diff", "px > tol");
+    for(int s = 0; s < size_count; ++s)
+    {
+        rasterizers_match &= bench_rasterizers(ttf, argc > 2 ? atoi(argv[2 + s]) : default_sizes[s]);
+    }
+    if(!rasterizers_match)
+    {
+        fprintf(stderr, "built-in rasterizer differs from stb_truetype by more than %d per pixel\n", BENCH_RASTER_TOLERANCE);
+        free(ttf);
+        return 1;
+    }
+#endif
+
+    free(ttf);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+
+vertext_bench_fontstash.c
+
+    fontstash side of vertext_bench.cpp. fontstash compiles its own stb_truetype implementation
+    (with its own allocator), so it can't share a translation unit with vertext's.
+    See vertext_bench.cpp for how to build it.
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#define FONTSTASH_IMPLEMENTATION
+#include "fontstash.h"
+
+#define BENCH_FONS_ATLAS_SIZE 1024
+
+static FONScontext* bench_fons;
+static int bench_fons_font;
+
+int bench_fontstash_init(unsigned char* ttf, int ttf_size, int text_height_px, int* atlas_bytes_out)
+{
+    FONSparams params;
+    memset(&params, 0, sizeof(params));
+    params.width = BENCH_FONS_ATLAS_SIZE;
+    params.height = BENCH_FONS_ATLAS_SIZE;
+    params.flags = FONS_ZERO_TOPLEFT;
+    bench_fons = fonsCreateInternal(&params);
+    if(!bench_fons)
+    {
+        return 0;
+    }
+    bench_fons_font = fonsAddFontMem(bench_fons, "bench", ttf, ttf_size, 0);
+    if(bench_fons_font == FONS_INVALID)
+    {
+        fonsDeleteInternal(bench_fons);
+        bench_fons = NULL;
+        return 0;
+    }
+    fonsSetFont(bench_fons, bench_fons_font);
+    fonsSetSize(bench_fons, (float)text_height_px);
+
+    // fontstash rasterizes glyphs the first time they are drawn, so the printable ASCII range is
+    // pushed through once here to make init comparable with the generators that bake up front.
+    char ascii[96];
+    for(int c = 32; c < 127; ++c)
+    {
+        ascii[c - 32] = (char)c;
+    }
+    ascii[95] = '\0';
+    FONStextIter iter;
+    FONSquad q;
+    fonsTextIterInit(bench_fons, &iter, 0.f, 0.f, ascii, NULL);
+    while(fonsTextIterNext(bench_fons, &iter, &q))
+    {
+    }
+
+    *atlas_bytes_out = BENCH_FONS_ATLAS_SIZE * BENCH_FONS_ATLAS_SIZE;
+    return 1;
+}
+
+int bench_fontstash_layout(const char* const* lines, int line_count, int text_height_px, float* out)
+{
+    int quad_count = 0;
+    float y = (float)text_height_px;
+    for(int i = 0; i < line_count; ++i, y += (float)text_height_px)
+    {
+        FONStextIter iter;
+        FONSquad q;
+        fonsTextIterInit(bench_fons, &iter, 0.f, y, lines[i], NULL);
+        while(fonsTextIterNext(bench_fons, &iter, &q))
+        {
+            const float v[6][4] = {
+                { q.x0, q.y1, q.s0, q.t1 }, { q.x1, q.y0, q.s1, q.t0 }, { q.x0, q.y0, q.s0, q.t0 },
+                { q.x1, q.y1, q.s1, q.t1 }, { q.x1, q.y0, q.s1, q.t0 }, { q.x0, q.y1, q.s0, q.t1 },
+            };
+            memcpy(out, v, sizeof(v));
+            out += 24;
+            ++quad_count;
+        }
+    }
+    return quad_count;
+}
+
+void bench_fontstash_shutdown()
+{
+    if(bench_fons)
+    {
+        fonsDeleteInternal(bench_fons);
+        bench_fons = NULL;
+    }
+}
@@ -1,960 +1,6647 @@
-/*
-
-vertext.h
-
-                                    .                             .
-                                 .o8                           .o8
-oooo    ooo  .ooooo.  oooo d8b .o888oo  .ooooo.  oooo    ooo .o888oo
- `88.  .8'  d88' `88b `888""8P   888   d88' `88b  `88b..8P'    888
-  `88..8'   888ooo888  888       888   888ooo888    Y888'      888
-   `888'    888    .o  888       888 . 888    .o  .o8"'88b     888 .
-    `8'     `Y8bod8P' d888b      "888" `Y8bod8P' o88'   888o   "888"
-
-
-
-By Kevin Chin 2022 (https://kevch.in/)
-
-    Requires stb_truetype.h (https://github.com/nothings/stb/blob/master/stb_truetype.h)
-    Do this:
-        #define VERTEXT_IMPLEMENTATION
-    before you include this file in *one* C or C++ file to create the implementation.
-        // i.e. it should look like this:
-        #include ...
-        #include ...
-        #define STB_TRUETYPE_IMPLEMENTATION
-        #include "stb_truetype.h"
-        #define VERTEXT_IMPLEMENTATION
-        #include "vertext.h"
-
-INTRO & PURPOSE:
-    Single-header C library to generate textured quads for rendering text to the screen.
-    This library does not perform rendering directly and instead provides a vertex buffer
-    of vertices (in either Screen Space or Clip Space) and texture coordinates. This allows
-    the library to work seamlessly with both OpenGL and DirectX. Probably also works with
-    other graphics APIs too...
-
-    Text rendering is a non-trivial task, and this library strives to make it easy and frictionless.
-
-    This library strives to solve 2 problems:
-    - Creating an individual vertex buffer / textured quad for every single character you
-    want to draw is extremely inefficient - especially if each character has their own
-    texture that needs to be binded to the graphics card.
-    - Every character/glyph has varying sizes and parameters that affect how they should
-    be drawn relative to all the other characters/glyphs. These must be considered when
-    drawing a line of text.
-
-    This library solves these problems by 
-        1.  generating a single, large texture combining all the individual textures of the
-            characters - called a font Texture Atlas
-        2.  generating a single vertex buffer containing the vertices of all the quads 
-            (https://en.wikipedia.org/wiki/Quadrilateral - one quad can draw one character) 
-            required by the text you want to draw
-        3.  handling the assembly of the quad vertices for the single vertex buffer by
-            using the character/glyph metrics (size, offsets, etc.)
-
-CONCEPT:
-    This library serves as a text drawing "canvas". 
-    You can "append" lines of text or characters to the "canvas". You can control where
-    the text gets "appended" to the "canvas" by moving the "cursor" (setting its location
-    on the screen). Then when you want to draw the "canvas" with your graphics API (OpenGL, 
-    DirectX, etc.), you can "grab" the "canvas" (vertex buffer).
-    Then, it is up to you and your graphics API to create the VAO and VBO on the graphics card
-    using the vertex buffer you "grabbed" from this library.
-    Check the USAGE EXAMPLEs below to see how this would translate to code.
-
-USAGE:
-    This library REQUIRES Sean Barrett's stb_truetype.h to be included beforehand:
-    https://raw.githubusercontent.com/nothings/stb/master/stb_truetype.h
-
-    This library's purpose is to return an array of vertices and texture coordinates:
-        [ x, y, u, v, x, y, u, v, ......, x, y, u, v ]
-    You can feed this into a Vertex Buffer with a Stride of 4.
-
-    Since this library only returns an array of vertex and texture coordinates, you 
-    should be able to feed that array into the vertex buffer of any graphics API and 
-    get it working.
-
-    You can also make the library create and return an index buffer if you are using indexed
-    drawing. You don't need to do this if you are not using indexed drawing.
-    See the following links if you don't know what vertex indices or index buffers are:
-    http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-9-vbo-indexing/
-    https://www.learnopengles.com/tag/index-buffer-object/
-
-    This library is not responsible for telling the graphics card to render text. You can
-    do that on your own in your preferred graphics API using the vertex buffer (and index
-    buffer if you enabled index drawing) that this library creates and a quad/ui rendering shader.
-    
-    > Vertex Coordinates:
-        By default, Screen Space coordinates are generated instead of Clip Space coordinates.
-
-        Quick reminder - Screen Space coordinates are where the top left corner of the
-        window/screen is defined as x: 0, y: 0 and the bottom right corner is x: window width,
-        y: window height. Clip Space coordinates are where the top left corner is x: -1, y: 1
-        and the bottom right corner is x: 1, y: -1 (with 0, 0 being the center of the window).
-        (https://learnopengl.com/Getting-started/Coordinate-Systems)
-
-        You can pick which coordinate system to generate vertices for. If you already have an
-        orthographic projection matrix for rendering UI or text, then you can make this library
-        generate Screen Space coordinates and apply the orthographic projection matrix in your
-        UI or text shader. You could also just create an orthographic projection matrix for this
-        text-rendering purpose:
-        https://glm.g-truc.net/0.9.1/api/a00237.html#ga71777a3b1d4fe1729cccf6eda05c8127
-        https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glOrtho.xml
-
-        If you just want to use Clip Space coordinates, then you need to set the flag for it:
-            vtxt_setflags(VTXT_USE_CLIPSPACE_COORDS);
-        and tell the library the window size:
-            vtxt_backbuffersize(WIDTH, HEIGHT);
-        If you are using Screen Space coordinates, you don't need to do any of that.
-
-    > Config Flags:
-        Use the following flags with vtxt_setflags(_flags_):
-        VTXT_CREATE_INDEX_BUFFER:
-            Sets the libary to use indexed vertices and return a index buffer as well when
-            grabbing buffers.
-        VTXT_USE_CLIPSPACE_COORDS:
-            Sets the library to use generate vertices in Clip Space coordinates instead of
-            Screen Space coordinates.
-        VTXT_NEWLINE_ABOVE:
-            Sets the library to move the cursor above the current line instead of below
-            when calling vtxt_new_line.
-        VTXT_FLIP_Y:
-            Flips y vertex position in case you are using a coordinate system where "up" is negative y.
-
-    > By Default:
-        - no indexed drawing (unless specified with flag VTXT_CREATE_INDEX_BUFFER)
-        - generates vertices in screenspace coordinates (unless specified with flag VTXT_USE_CLIPSPACE_COORDS)
-        - "next line" is the line below the line we are on (unless specified with flag VTXT_NEWLINE_ABOVE)
-
-    > The following "#define"s are unnecessary but optional:
-        #define VTXT_MAX_CHAR_IN_BUFFER X (before including this library) where X is the
-        maximum number of characters you want to allow in the vertex buffer at once. By default this value
-        is 800 characters. Consider your memory use when setting this value because the memory for the
-        vertex buffer and index buffers are located in the .data segment of the program's alloted memory.
-        Every character increases the combined size of the two buffers by 120 bytes (e.g. 800 characters
-        allocates 800 * 120 = 96000 bytes in the .data segment of memory)
-            e.g. #define VTXT_MAX_CHAR_IN_BUFFER 500
-                 #define VERTEXT_IMPLEMENTATION
-                 #include "vertext.h"
-
-        #define VTXT_ASCII_FROM X and #define VTXT_ASCII_TO Y where X and Y are the start and
-        end ASCII codepoints to collect the font data for. In other words, if X is the character 'a' and Y is
-        the character 'z', then the library will only collect the font data for the ASCII characters from 'a'
-        to 'z'. By default, the start and end codepoints are set to ' ' and '~'.
-            e.g. #define VTXT_ASCII_FROM 'a'
-                 #define VTXT_ASCII_TO 'z'
-                 #define VERTEXT_IMPLEMENTATION
-                 #include "vertext.h"
-
-        #define VTXT_STATIC to make function declarations and function definitions static. This makes
-        the implementation private to the source file that creates it. This allows you to have multiple
-        instances of this library in your project without collision. You could use multiple vertex
-        buffers at the same time without clearing the buffers.
-
-    > Things to be aware of:
-        - vtxt_font is around ~4KB, so don't copy it around. Just declare it once and then pass around
-          a POINTER to it instead of passing it around by value.
-
-    > Some types:
-        vtxt_vertex_buffer - see comment at definition - This is what you want to get back from this library
-        vtxt_bitmap - see comment at definition - basically data and pointer to bitmap image in memory
-        vtxt_glyph - see comment at definition - info about specific ASCII glyph
-        vtxt_font - see comment at definition - info about font - HUGE struct
-
-EXAMPLE (Pseudocode):
-
-Do only once:
-    Optional:   vtxt_setflags(VTXT_CREATE_INDEX_BUFFER);                <-- Configures the library with given flags
-                            |
-                            V
-    Optional:   vtxt_backbuffersize(window width=1920, window height=1080);  <-- Only required if using VTXT_USE_CLIPSPACE_COORDS
-                            |
-                            V
-    Required:   vtxt_init_font(font_handle, font_buffer, font_height_px);   <-- DO ONLY ONCE PER FONT (or per font resolution)
-
-Loop:
-    Optional:   vtxt_move_cursor(x = 640, y = 360);                      <-- Set the cursor to x y (where to start drawing)
-                            |
-                            V
-    Required:   vtxt_append_line("some text", font_handle, text_height_px);   <-- text to draw
-                            |
-                            V
-    Optional:   vtxt_new_line(x = 640, font);                            <-- Go to next line, set cursor x to 640
-                            |
-                            V
-    Optional:   vtxt_append_line("next lin", font_handle, text_height_px);    <-- next line to draw
-                            |
-                            V
-    Optional:   vtxt_append_glyph('e', font_handle, text_height_px);          <-- Can append individual glyphs also
-                            |
-                            V
-    Required:   vtxt_vertex_buffer grabbedBuffer = vtxt_grab_buffer();    <-- Grabs the buffer
-                            |
-                            V
-    Required:   * create/bind Vertex Array Object and Vertex Buffer Objects on GPU using your graphics API and grabbedBuffer
-                            |
-                            V
-    Optional:   vtxt_clear_buffer();           <-- REQUIRED IF you want to clear the appended text to append NEW text
-                                                    Only clear AFTER you bind the vertex and index buffers of grabbedBuffer
-                                                    to the VAO and VBO on the GPU.
-
-
-EXAMPLE (C code using OpenGL):
-
-    #define TEXT_SIZE 30
-
-    unsigned char* font_file;
-    // Read the font file on disk (e.g. "arial.ttf") into a byte buffer in memory (e.g. font_file) using your own method
-    // If you are using SDL, you can use SDL_RW. You could also use stdio.h's file operations (fopen, fread, fclose, etc.).
-    
-    vtxt_setflags(VTXT_CREATE_INDEX_BUFFER|VTXT_USE_CLIPSPACE_COORDS);     // vertext.h setting
-    vtxt_backbuffersize(WIDTH, HEIGHT);
-
-    vtxt_font font_handle;
-    vtxt_init_font(&font_handle, font_file, TEXT_SIZE);
-    // TEXT_SIZE in init_font doesn't need to be the same as the TEXT_SIZE we use when we call append_line or glyph
-    // Now font_handle has all the info we need.
-
-    vtxt_clear_buffer();
-    vtxt_move_cursor(100, 100);
-    vtxt_append_line("Hello, world!", &font_handle);
-
-    vtxt_vertex_buffer vb = vtxt_grab_buffer();
-
-    // That's it. That's all you need to interact with this library. Everything below is just
-    // using the vertex buffer from the library to actually get the text drawing in OpenGL.
-
-
-    GLuint VAO_ID, VBO_ID, IBO_ID, TextureID;
-    // Creating the VAO for our text in the GPU memory
-    glBindVertexArray(VAO_ID);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO_ID);
-            glBufferData(GL_ARRAY_BUFFER,
-                         vb.vertices_array_count * 4,
-                         vb.vertex_buffer,
-                         GL_STATIC_DRAW);
-            glEnableVertexAttribArray(0); // vertices coordinates stream
-            glVertexAttribPointer(0, 2, // 2 because vertex is 2 floats (x and y)
-                                  GL_FLOAT, GL_FALSE,
-                                  4*4,  // 4 stride (x y u v) * 4 bytes (size of float)
-                                  0);
-            glEnableVertexAttribArray(1); // texture coordinates stream
-            glVertexAttribPointer(0, 2, // 2 because texture coord is 2 floats (u and v)
-                                  GL_FLOAT, GL_FALSE,
-                                  4*4,  // 4 stride (x y u v) * 4 bytes (size of float)
-                                  2*4); // offset of 8 because two floats, x y, come before u v
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO_ID);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                         vb.indices_array_count * 4,
-                         vb.index_buffer,
-                         GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    // Creating the font texture in GPU memory
-    glGenTextures(1, &TextureID);     
-    glBindTexture(GL_TEXTURE_2D, TextureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,       // for both the target and source format, we can put GL_RED
-                     font_handle.font_atlas.width,   // this just means the bit depth is 1 byte (just the alpha)
-                     font_handle.font_atlas.height, 
-                     0, GL_RED, GL_UNSIGNED_BYTE, 
-                     font_handle.font_atlas.pixels);
-    glActiveTexture(GL_TEXTURE0);
-    // Draw call
-    glUseProgram(SHADER PROGRAM FOR TEXT); // The text shader should use an orthographic projection matrix
-    glBindVertexArray(mesh.id_vao);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.id_ibo);
-            glDrawElements(GL_TRIANGLES, vb.indices_array_count, GL_UNSIGNED_INT, nullptr);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glUseProgram(0);
-
-TODO:
-    - Signed Distance Fields
-    - Kerning
-    - Top-to-bottom text (vertical text)
-    - Add flag to choose winding order (currently counter-clockwise winding order)
-*/
-#ifndef _INCLUDE_VERTEXT_H_
-#define _INCLUDE_VERTEXT_H_
-
-#ifndef VTXT_ASCII_FROM
-#define VTXT_ASCII_FROM ' '    // starting ASCII codepoint to collect font data for
-#endif
-#ifndef VTXT_ASCII_TO
-#define VTXT_ASCII_TO '~'      // ending ASCII codepoint to collect font data for
-#endif
-#define VTXT_GLYPH_COUNT VTXT_ASCII_TO - VTXT_ASCII_FROM + 1
-
-#ifdef VTXT_STATIC
-#define VTXT_DEF static
-#else
-#define VTXT_DEF extern
-#endif
-
-/** Stores a pointer to the vertex buffer assembly array and the count of vertices in the 
-    array (total length of array would be count of vertices * 4).
-*/
-typedef struct vtxt_vertex_buffer
-{
-    int             vertex_count;           // count of vertices in vertex buffer array (4 elements per vertex, so vertices_array_count / 4 = vertex_count)
-    int             vertices_array_count;   // count of elements in vertex buffer array
-    int             indices_array_count;    // count of elements in index buffer array
-    float*          vertex_buffer;          // pointer to vertex buffer array
-    unsigned int*   index_buffer;           // pointer to index buffer array
-} vtxt_vertex_buffer;
-
-/** vtxt_bitmap is a handle to hold a pointer to an unsigned byte bitmap in memory. Length/count
-    of bitmap elements = width * height.
-*/
-typedef struct vtxt_bitmap
-{
-    int             width;      // bitmap width
-    int             height;     // bitmap height
-    unsigned char*  pixels;     // unsigned byte bitmap
-} vtxt_bitmap;
-
-/** Stores information about a glyph. The glyph is identified via codepoint (ASCII).
-    Check out https://learnopengl.com/img/in-practice/glyph.png 
-    Learn more about glyph metrics if you want.
-*/
-typedef struct vtxt_glyph
-{
-    float           width, height, advance,offset_x,offset_y,min_u,min_v,max_u,max_v;
-    char            codepoint;
-} vtxt_glyph;
-
-/** vtxt_font is a handle to hold font information. It's around ~4KB, so don't copy it around all the time.
-*/
-typedef struct vtxt_font
-{
-    int             font_height_px;             // how tall the font's vertical extent is in pixels
-    float           ascender;                   // https://en.wikipedia.org/wiki/Ascender_(typography)
-    float           descender;                  // https://en.wikipedia.org/wiki/Descender
-    float           linegap;                    // gap between the bottom of the descender of one line to the top of the ascender of the line below
-    vtxt_bitmap     font_atlas;                 // stores the bitmap for the font texture atlas (https://en.wikipedia.org/wiki/Texture_atlas#/media/File:Texture_Atlas.png)
-    vtxt_glyph      glyphs[VTXT_GLYPH_COUNT];   // array for glyphs information
-} vtxt_font;
-
-enum _vtxt_config_flags_t
-{
-    VTXT_CREATE_INDEX_BUFFER     = 1 << 0,
-    VTXT_USE_CLIPSPACE_COORDS    = 1 << 1,
-    VTXT_NEWLINE_ABOVE           = 1 << 2,
-    VTXT_FLIP_Y                  = 1 << 3,
-};
-
-/** Configures this library to use the settings defined by _vtxt_config_flags_t.
-    e.g. vtxt_setflags(VTXT_CREATE_INDEX_BUFFER | VTXT_USE_CLIPSPACE_COORDS);
-*/
-VTXT_DEF void vtxt_setflags(int newconfig);
-
-/** ONLY IF YOU WANT CLIPSPACE COORDINATES INSTEAD OF SCREENSPACE COORDINATES
-    Tells vertext.h the size of your application's backbuffer size. If the
-    backbuffer size changes, then you should call this again to update the size.
-*/
-VTXT_DEF void vtxt_backbuffersize(int width, int height);
-
-/** Initializes a vtxt_font font handle to store glyphs information, font information, and the font texture atlas.
-    Collects the glyphs and font information from the font file (given as a binary buffer in memory)
-    and generates the font texture atlas (https://en.wikipedia.org/wiki/Texture_atlas#/media/File:Texture_Atlas.png)
-    Expensive, so you should only do this ONCE per font (and font size) and just keep the vtxt_font around somewhere.
-    font_height_in_pixels := How tall the font's vertical extent (above the baseline) should be in pixels
-*/
-VTXT_DEF void vtxt_init_font(vtxt_font*       font_handle,
-                             unsigned char*   font_buffer,
-                             int              font_height_in_pixels);
-
-/** Move cursor location (cursor represents the position on the screen where text is placed)
-*/
-VTXT_DEF void vtxt_move_cursor(int x,
-                               int y);
-
-/** Go to new line and set X location of cursor
-*/
-VTXT_DEF void vtxt_new_line(int          x,
-                            vtxt_font*   font,
-                            int          text_height_px);
-
-/** Assemble quads for a line of text and append to vertex buffer.
-    line_of_text is the text you want to draw e.g. "some text I want to Draw".
-    font is the vtxt_font font handle that contains the font you want to use.
-    text_height_px is the desired text height in pixels.
-*/
-VTXT_DEF void vtxt_append_line(const char*   line_of_text,
-                               vtxt_font*    font,
-                               int           text_height_px);
-
-/** Same as vtxt_append_line but center horizontally where the cursor is. */
-VTXT_DEF void vtxt_append_line_centered(const char* line_of_text,
-                                        vtxt_font*  font,
-                                        int         text_height_px);
-
-/** Same as vtxt_append_line but with text using right-alignment (the text is to the left of the cursor). */
-VTXT_DEF void vtxt_append_line_align_right(const char* line_of_text, 
-                                           vtxt_font*  font, 
-                                           int         text_height_px);
-
-/** Assemble quad for a glyph and append to vertex buffer.
-    font is the vtxt_font font handle that contains the font you want to use.
-    text_height_px is the maximum vertical extent of the glyph in pixels
-*/
-VTXT_DEF void vtxt_append_glyph(const char   in_glyph,
-                                vtxt_font*   font,
-                                int          text_height_px);
-
-/** Get vtxt_vertex_buffer with a pointer to the vertex buffer array
-    and vertex buffer information.
-*/
-VTXT_DEF vtxt_vertex_buffer vtxt_grab_buffer();
-
-/** Call before starting to append new text.
-    Clears the vertex buffer that text is being appended to. 
-    If you called vtxt_grab_buffer and want to use the buffer you received,
-    make sure you pass the buffer to OpenGL (glBufferData) or make a copy of
-    the buffer before calling vtxt_clear_buffer.
-*/
-VTXT_DEF void vtxt_clear_buffer();
-
-/** Set an offset to font linegap. Default is 0. */
-VTXT_DEF void vtxt_set_linegap_offset(float offset);
-
-/** Returns the width and height of the minimum bounding box containing
-    the given text using the given font and text height. */
-VTXT_DEF void vtxt_get_text_bounding_box_info(float* width_out,
-                                              float* height_out,
-                                              const char* text,
-                                              vtxt_font* font,
-                                              int text_height_px);
-
-
-#endif // _INCLUDE_VERTEXT_H_
-
-
-///////////////////// IMPLEMENTATION //////////////////////////
-#ifdef VERTEXT_IMPLEMENTATION
-
-#define _vtxt_internal static      // vtxt local static variable
-#ifndef VTXT_MAX_CHAR_IN_BUFFER
-#define VTXT_MAX_CHAR_IN_BUFFER 800    // maximum characters allowed in vertex buffer ("canvas")
-#endif
-#define VTXT_MAX_FONT_RESOLUTION 100   // maximum font resolution when initializing font
-#define VTXT_DESIRED_ATLAS_WIDTH 400   // width of the font atlas
-#define VTXT_ATLAS_PAD_X 1                // x padding between the glyph textures on the texture atlas
-#define VTXT_ATLAS_PAD_Y 1                // y padding between the glyph textures on the texture atlas
-
-#define _vtxt_ceil(num) ((num) == (float)((int)(num)) ? (int)(num) : (((int)(num)) + 1))
-
-// Buffers for vertices and texture_coords before they are written to GPU memory.
-// If you have a pointer to these buffers, DO NOT let these buffers be overwritten
-// before you bind the data to GPU memory.
-_vtxt_internal float _vtxt_vertex_buffer[VTXT_MAX_CHAR_IN_BUFFER * 6 * 4]; // 800 characters * 6 vertices * (2 xy + 2 uv)
-_vtxt_internal int _vtxt_vertex_count = 0; // Each vertex takes up 4 places in the assembly_buffer
-_vtxt_internal unsigned int _vtxt_index_buffer[VTXT_MAX_CHAR_IN_BUFFER * 6];
-_vtxt_internal int _vtxt_index_count = 0;
-_vtxt_internal int _vtxt_config = 0b0;
-_vtxt_internal float _vtxt_linegap_offset = 0.f;
-_vtxt_internal int _vtxt_cursor_x = 0;   // top left of the screen is pixel (0, 0), bot right of the screen is pixel (screen buffer width, screen buffer height)
-_vtxt_internal int _vtxt_cursor_y = 100; // cursor points to the base line at which to start drawing the glyph
-_vtxt_internal int _vtxt_screen_w_for_clipspace = 800;
-_vtxt_internal int _vtxt_screen_h_for_clipspace = 600;
-
-VTXT_DEF void
-vtxt_setflags(int newconfig)
-{
-    int oldconfig = _vtxt_config;
-    _vtxt_config = newconfig;
-
-    if((oldconfig & VTXT_CREATE_INDEX_BUFFER) != (_vtxt_config & VTXT_CREATE_INDEX_BUFFER))
-    {
-        vtxt_clear_buffer();
-    }
-}
-
-VTXT_DEF void
-vtxt_set_linegap_offset(float offset)
-{
-    _vtxt_linegap_offset = offset;
-}
-
-VTXT_DEF void
-vtxt_backbuffersize(int width, int height)
-{
-    _vtxt_screen_w_for_clipspace = width;
-    _vtxt_screen_h_for_clipspace = height;
-}
-
-VTXT_DEF void
-vtxt_init_font(vtxt_font* font_handle, unsigned char* font_buffer, int font_height_in_pixels)
-{
-    int desired_atlas_width = VTXT_DESIRED_ATLAS_WIDTH;
-
-    if(font_height_in_pixels > VTXT_MAX_FONT_RESOLUTION)
-    {
-        return;
-    }
-
-    // Font metrics
-    stbtt_fontinfo stb_font_info;
-    stbtt_InitFont(&stb_font_info, font_buffer, 0);
-    float stb_scale = stbtt_ScaleForMappingEmToPixels(&stb_font_info, (float)font_height_in_pixels);
-    int stb_ascender;
-    int stb_descender;
-    int stb_linegap;
-    stbtt_GetFontVMetrics(&stb_font_info, &stb_ascender, &stb_descender, &stb_linegap);
-    font_handle->font_height_px = font_height_in_pixels;
-    font_handle->ascender = (float)stb_ascender * stb_scale;
-    font_handle->descender = (float)stb_descender * stb_scale;
-    font_handle->linegap = (float)stb_linegap * stb_scale;
-
-    // LOAD GLYPH BITMAP AND INFO FOR EVERY CHARACTER WE WANT IN THE FONT
-    vtxt_bitmap temp_glyph_bitmaps[VTXT_GLYPH_COUNT];
-    int tallest_glyph_height = 0;
-    int aggregate_glyph_width = 0;
-    // load glyph data
-    for(char char_index = VTXT_ASCII_FROM; char_index <= VTXT_ASCII_TO; ++char_index) // ASCII
-    {
-        vtxt_glyph glyph;
-        
-        // get glyph metrics from stbtt
-        int stb_advance;
-        int stb_leftbearing;
-        stbtt_GetCodepointHMetrics(&stb_font_info, 
-                                   char_index, 
-                                   &stb_advance, 
-                                   &stb_leftbearing);
-        glyph.codepoint = char_index;
-        glyph.advance = (float)stb_advance * stb_scale;
-        int stb_width, stb_height;
-        int stb_offset_x, stb_offset_y;
-        unsigned char* stb_bitmap_temp = stbtt_GetCodepointBitmap(&stb_font_info,
-                                                                0, stb_scale,
-                                                                char_index,
-                                                                &stb_width,
-                                                                &stb_height,
-                                                                &stb_offset_x,
-                                                                &stb_offset_y);
-        glyph.width = (float)stb_width;
-        glyph.height = (float)stb_height;
-        glyph.offset_x = (float)stb_offset_x;
-        glyph.offset_y = (float)stb_offset_y;
-
-        // Copy stb_bitmap_temp bitmap into glyph's pixels bitmap so we can free stb_bitmap_temp
-        int iter = char_index - VTXT_ASCII_FROM;
-        temp_glyph_bitmaps[iter].pixels = (unsigned char*) calloc((size_t)glyph.width * (size_t)glyph.height, 1);
-        for(int row = 0; row < (int) glyph.height; ++row)
-        {
-            for(int col = 0; col < (int) glyph.width; ++col)
-            {
-                // Flip the bitmap image from top to bottom to bottom to top
-                temp_glyph_bitmaps[iter].pixels[row * (int) glyph.width + col] = stb_bitmap_temp[((int) glyph.height - row - 1) * (int) glyph.width + col];
-            }
-        }
-        temp_glyph_bitmaps[iter].width = (int) glyph.width;
-        temp_glyph_bitmaps[iter].height = (int) glyph.height;
-        aggregate_glyph_width += (int)glyph.width + VTXT_ATLAS_PAD_X;
-        if(tallest_glyph_height < (int)glyph.height)
-        {
-            tallest_glyph_height = (int)glyph.height;
-        }
-        stbtt_FreeBitmap(stb_bitmap_temp, 0);
-
-        font_handle->glyphs[iter] = glyph;
-    }
-
-    int desired_atlas_height = (tallest_glyph_height + VTXT_ATLAS_PAD_Y)
-                               * _vtxt_ceil((float)aggregate_glyph_width / (float)desired_atlas_width);
-    // Build font atlas bitmap based on these parameters
-    vtxt_bitmap atlas;
-    atlas.pixels = (unsigned char*) calloc(desired_atlas_width * desired_atlas_height, 1); // TODO avoid calloc here
-    atlas.width = desired_atlas_width;
-    atlas.height = desired_atlas_height;
-    // COMBINE ALL GLYPH BITMAPS INTO FONT ATLAS
-    int glyph_count = VTXT_GLYPH_COUNT;
-    int atlas_x = 0;
-    int atlas_y = 0;
-    for(int i = 0; i < glyph_count; ++i)
-    {
-        vtxt_bitmap glyph_bitmap = temp_glyph_bitmaps[i];
-        if (atlas_x + glyph_bitmap.width > atlas.width) // check if move atlas bitmap cursor to next line
-        {
-            atlas_x = 0;
-            atlas_y += tallest_glyph_height + VTXT_ATLAS_PAD_Y;
-        }
-
-        for(int glyph_y = 0; glyph_y < glyph_bitmap.height; ++glyph_y)
-        {
-            for(int glyph_x = 0; glyph_x < glyph_bitmap.width; ++glyph_x)
-            {
-                atlas.pixels[(atlas_y + glyph_y) * atlas.width + atlas_x + glyph_x]
-                    = glyph_bitmap.pixels[glyph_y * glyph_bitmap.width + glyph_x];
-            }
-        }
-        font_handle->glyphs[i].min_u = (float) atlas_x / (float) atlas.width;
-        font_handle->glyphs[i].min_v = (float) atlas_y / (float) atlas.height;
-        font_handle->glyphs[i].max_u = (float) (atlas_x + glyph_bitmap.width) / (float) atlas.width;
-        font_handle->glyphs[i].max_v = (float) (atlas_y + glyph_bitmap.height) / (float) atlas.height;
-
-        atlas_x += glyph_bitmap.width + VTXT_ATLAS_PAD_X; // move the atlas bitmap cursor by glyph bitmap width
-
-        free(glyph_bitmap.pixels);
-    }
-    font_handle->font_atlas = atlas;
-}
-
-VTXT_DEF void
-vtxt_move_cursor(int x, int y)
-{
-    _vtxt_cursor_x = x;
-    _vtxt_cursor_y = y;
-}
-
-VTXT_DEF void
-vtxt_new_line(int x, vtxt_font* font, int text_height_px)
-{
-    float scale = (float)text_height_px / (float)font->font_height_px;
-    float linegap = font->linegap + _vtxt_linegap_offset;
-    _vtxt_cursor_x = x;
-    if(_vtxt_config & VTXT_NEWLINE_ABOVE)
-    {
-        if(_vtxt_config & VTXT_FLIP_Y)
-        {
-            _vtxt_cursor_y += (int) ((-font->descender + linegap + font->ascender)*scale);
-        }
-        else
-        {
-            _vtxt_cursor_y -= (int) ((-font->descender + linegap + font->ascender)*scale);
-        }
-    }
-    else
-    {
-        if(_vtxt_config & VTXT_FLIP_Y)
-        {
-            _vtxt_cursor_y -= (int) ((-font->descender + linegap + font->ascender)*scale);
-        }
-        else
-        {
-            _vtxt_cursor_y += (int) ((-font->descender + linegap + font->ascender)*scale);
-        }
-    }
-}
-
-VTXT_DEF void
-__private_vtxt_append_glyph(const char in_glyph, vtxt_font* font, int text_height_px, float x_offset_from_cursor)
-{
-    if(in_glyph < VTXT_ASCII_FROM || in_glyph > VTXT_ASCII_TO) // Make sure we have the data for this glyph
-    {
-        return;
-    }
-
-    if(VTXT_MAX_CHAR_IN_BUFFER * 6 < _vtxt_vertex_count + 6) // Make sure we are not exceeding the array size
-    {
-        return;
-    }
-
-    float scale = (float)text_height_px / (float)font->font_height_px;
-    vtxt_glyph glyph = font->glyphs[in_glyph - VTXT_ASCII_FROM];
-    glyph.advance *= scale;
-    glyph.width *= scale; // NOTE(Kevin): 2022-06-15 scale was float, but width and height were integers so rounding was causing text to render strangely - fixed by just changing width and height to floats
-    glyph.height *= scale;
-    glyph.offset_x *= scale;
-    glyph.offset_y *= scale;
-
-    // For each of the 6 vertices, fill in the _vtxt_vertex_buffer in the order x y u v
-    int STRIDE = 4;
-
-    float top = _vtxt_cursor_y + glyph.offset_y;
-    float bot = _vtxt_cursor_y + glyph.offset_y + glyph.height;
-    float left = _vtxt_cursor_x + glyph.offset_x + x_offset_from_cursor;
-    float right = _vtxt_cursor_x + glyph.offset_x + glyph.width + x_offset_from_cursor;
-    if(_vtxt_config & VTXT_FLIP_Y)
-    {
-        top = _vtxt_cursor_y - glyph.offset_y;
-        bot = _vtxt_cursor_y - glyph.offset_y - glyph.height;
-    }
-
-    if(_vtxt_config & VTXT_USE_CLIPSPACE_COORDS)
-    {
-        top = (1.f - ((top / _vtxt_screen_h_for_clipspace) * 2.f));
-        bot = (1.f - ((bot / _vtxt_screen_h_for_clipspace) * 2.f));
-        left = ((left / _vtxt_screen_w_for_clipspace) * 2.f) - 1.f;
-        right = ((right / _vtxt_screen_w_for_clipspace) * 2.f) - 1.f;
-    }
-
-    if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
-    {
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 0] = left;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 1] = bot;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 2] = glyph.min_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 3] = glyph.min_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 4] = left;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 5] = top;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 6] = glyph.min_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 7] = glyph.max_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 8] = right;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 9] = top;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 10] = glyph.max_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 11] = glyph.max_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 12] = right;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 13] = bot;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 14] = glyph.max_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 15] = glyph.min_v;
-
-        _vtxt_index_buffer[_vtxt_index_count + 0] = _vtxt_vertex_count + 0;
-        _vtxt_index_buffer[_vtxt_index_count + 1] = _vtxt_vertex_count + 2;
-        _vtxt_index_buffer[_vtxt_index_count + 2] = _vtxt_vertex_count + 1;
-        _vtxt_index_buffer[_vtxt_index_count + 3] = _vtxt_vertex_count + 0;
-        _vtxt_index_buffer[_vtxt_index_count + 4] = _vtxt_vertex_count + 3;
-        _vtxt_index_buffer[_vtxt_index_count + 5] = _vtxt_vertex_count + 2;
-
-        _vtxt_vertex_count += 4;
-        _vtxt_index_count += 6;
-    }
-    else
-    {
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 0] = left;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 1] = bot;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 2] = glyph.min_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 3] = glyph.min_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 4] = right;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 5] = top;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 6] = glyph.max_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 7] = glyph.max_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 8] = left;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 9] = top;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 10] = glyph.min_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 11] = glyph.max_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 12] = right;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 13] = bot;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 14] = glyph.max_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 15] = glyph.min_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 16] = right;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 17] = top;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 18] = glyph.max_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 19] = glyph.max_v;
-
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 20] = left;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 21] = bot;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 22] = glyph.min_u;
-        _vtxt_vertex_buffer[_vtxt_vertex_count * STRIDE + 23] = glyph.min_v;
-
-        _vtxt_vertex_count += 6;
-    }
-
-    // Advance the cursor
-    _vtxt_cursor_x += (int) glyph.advance;
-}
-
-VTXT_DEF void
-vtxt_append_glyph(const char in_glyph, vtxt_font* font, int text_height_px)
-{
-    __private_vtxt_append_glyph(in_glyph, font, text_height_px, 0.f);
-}
-
-VTXT_DEF void
-vtxt_append_line(const char* line_of_text, vtxt_font* font, int text_height_px)
-{
-    int line_start_x = _vtxt_cursor_x;
-    while(*line_of_text != '\0')
-    {
-        if(*line_of_text != '\n')
-        {
-            if(VTXT_MAX_CHAR_IN_BUFFER * 6 < _vtxt_vertex_count + 6) // Make sure we are not exceeding the array size
-            {
-                break;
-            }
-            vtxt_append_glyph(*line_of_text, font, text_height_px);
-        }
-        else
-        {
-            vtxt_new_line(line_start_x, font, text_height_px);
-        }
-        ++line_of_text;// next character
-    }
-}
-
-VTXT_DEF void
-vtxt_append_line_align_right(const char* line_of_text, vtxt_font* font, int text_height_px)
-{
-    int line_start_x = _vtxt_cursor_x;
-    char line_buffer[256];
-    int lb_index = 0;
-    while (*line_of_text != '\0' && *line_of_text != '\n')
-    {
-        line_buffer[lb_index++] = *line_of_text++;
-    }
-    float line_length = 0.f;
-    for (int i = 0; i < lb_index; ++i)
-    {
-        char in_glyph = line_buffer[i];
-        float scale = (float)text_height_px / (float)font->font_height_px;
-        vtxt_glyph glyph = font->glyphs[in_glyph - VTXT_ASCII_FROM];
-        glyph.advance *= scale;
-        line_length += glyph.advance;
-    }
-    for (int i = 0; i < lb_index; ++i)
-    {
-        char in_glyph = line_buffer[i];
-        if (VTXT_MAX_CHAR_IN_BUFFER * 6 < _vtxt_vertex_count + 6) // Make sure we are not exceeding the array size
-        {
-            break;
-        }
-        __private_vtxt_append_glyph(in_glyph, font, text_height_px, -line_length);
-    }
-
-    if (*line_of_text == '\n')
-    {
-        vtxt_new_line(line_start_x, font, text_height_px);
-        ++line_of_text;
-        vtxt_append_line_align_right(line_of_text, font, text_height_px);
-    }
-    else // terminate
-    {
-
-    }
-}
-
-VTXT_DEF void
-vtxt_append_line_centered(const char* line_of_text, vtxt_font* font, int text_height_px)
-{
-    int line_start_x = _vtxt_cursor_x;
-    char line_buffer[256];
-    int lb_index = 0;
-    while(*line_of_text != '\0' && *line_of_text != '\n')
-    {
-        line_buffer[lb_index++] = *line_of_text++;
-    }
-    float line_length = 0.f;
-    for(int i = 0; i < lb_index; ++i)
-    {
-        char in_glyph = line_buffer[i];
-        float scale = (float)text_height_px / (float)font->font_height_px;
-        vtxt_glyph glyph = font->glyphs[in_glyph - VTXT_ASCII_FROM];
-        glyph.advance *= scale;
-        line_length += glyph.advance;
-    }
-    float half_line_length = line_length/2.f;
-    for(int i = 0; i < lb_index; ++i)
-    {    
-        char in_glyph = line_buffer[i];
-        if(VTXT_MAX_CHAR_IN_BUFFER * 6 < _vtxt_vertex_count + 6) // Make sure we are not exceeding the array size
-        {
-            break;
-        }
-        __private_vtxt_append_glyph(in_glyph, font, text_height_px, -half_line_length);
-    }
-
-    if(*line_of_text == '\n')
-    {
-        vtxt_new_line(line_start_x, font, text_height_px);
-        ++line_of_text;
-        vtxt_append_line_centered(line_of_text, font, text_height_px);
-    }
-    else // terminate
-    {
-
-    }
-}
-
-VTXT_DEF void
-vtxt_get_text_bounding_box_info(float* width_out,
-                                float* height_out,
-                                const char* text,
-                                vtxt_font* font,
-                                int text_height_px)
-{
-    float wSumLargestSoFar = 0;
-    float wSumCurrent = 0;
-    float hSum = 0;
-
-    while (*text != '\0')
-    {
-        if (*text != '\n')
-        {
-            if (*text < VTXT_ASCII_FROM || *text > VTXT_ASCII_TO) // Make sure we have the data for this glyph
-            {
-                continue;
-            }
-
-            bool isLastGlyphInLine = *(text + 1) == '\0' || *(text + 1) == '\n';
-            float scale = (float)text_height_px / (float)font->font_height_px;
-            vtxt_glyph glyph = font->glyphs[*text - VTXT_ASCII_FROM];
-            glyph.advance *= scale;
-            glyph.width *= scale;
-            glyph.height *= scale;
-            glyph.offset_x *= scale;
-            glyph.offset_y *= scale;
-
-            wSumCurrent += isLastGlyphInLine ? glyph.offset_x + glyph.width : glyph.advance;
-
-            if (isLastGlyphInLine)
-            {
-                if (wSumCurrent > wSumLargestSoFar)
-                {
-                    wSumLargestSoFar = wSumCurrent;
-                }
-
-                float linegap = font->linegap + _vtxt_linegap_offset;
-                float heightOfThisLine = (font->ascender - font->descender + linegap) * scale;
-                // Note(Kevin): honestly could prob just use the tallest glyph.height + glyph.offset_y instead
-                // TODO(Kevin): Only add font->linegap if there is a new line with legit characters
-                hSum += heightOfThisLine;
-            }
-        }
-        ++text; // next character
-    }
-
-    *width_out = wSumLargestSoFar;
-    *height_out = hSum;
-}
-
-VTXT_DEF vtxt_vertex_buffer
-vtxt_grab_buffer()
-{
-    vtxt_vertex_buffer retval;
-    retval.vertex_buffer = _vtxt_vertex_buffer;
-    if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
-    {
-        retval.vertices_array_count = _vtxt_vertex_count * 4;
-        retval.index_buffer = _vtxt_index_buffer;
-        retval.indices_array_count = _vtxt_index_count;
-    }
-    else
-    {
-        retval.vertices_array_count = _vtxt_vertex_count * 6;
-        retval.index_buffer = NULL;
-        retval.indices_array_count = 0;
-    }
-    retval.vertex_count = _vtxt_vertex_count;
-    return retval;
-}
-
-VTXT_DEF void
-vtxt_clear_buffer()
-{
-    // No need to actually clear the vertex and index buffers back to 0
-    // Setting the counts back to 0 will suffice
-    _vtxt_vertex_count = 0;
-    _vtxt_index_count = 0;
-}
-
-// clean up
-#undef VTXT_DEF
-#undef _vtxt_internal
-#undef VTXT_ASCII_FROM
-#undef VTXT_ASCII_TO
-#undef VTXT_MAX_CHAR_IN_BUFFER
-#undef VTXT_GLYPH_COUNT
-#undef VTXT_MAX_FONT_RESOLUTION
-#undef VTXT_DESIRED_ATLAS_WIDTH
-#undef VTXT_ATLAS_PAD_X
-#undef VTXT_ATLAS_PAD_Y
-
-#undef VERTEXT_IMPLEMENTATION
-#endif // VERTEXT_IMPLEMENTATION
+/*
+
+vertext.h
+
+                                    .                             .
+                                 .o8                           .o8
+oooo    ooo  .ooooo.  oooo d8b .o888oo  .ooooo.  oooo    ooo .o888oo
+ `88.  .8'  d88' `88b `888""8P   888   d88' `88b  `88b..8P'    888
+  `88..8'   888ooo888  888       888   888ooo888    Y888'      888
+   `888'    888    .o  888       888 . 888    .o  .o8"'88b     888 .
+    `8'     `Y8bod8P' d888b      "888" `Y8bod8P' o88'   888o   "888"
+
+
+
+By Kevin Chin 2022 (https://kevch.in/)
+
+    Requires stb_truetype.h (https://github.com/nothings/stb/blob/master/stb_truetype.h)
+    Do this:
+        #define VERTEXT_IMPLEMENTATION
+    before you include this file in *one* C or C++ file to create the implementation.
+        // i.e. it should look like this:
+        #include ...
+        #include ...
+        #define STB_TRUETYPE_IMPLEMENTATION
+        #include "stb_truetype.h"
+        #define VERTEXT_IMPLEMENTATION
+        #include "vertext.h"
+
+INTRO & PURPOSE:
+    Single-header C library to generate textured quads for rendering text to the screen.
+    This library does not perform rendering directly and instead provides a vertex buffer
+    of vertices (in either Screen Space or Clip Space) and texture coordinates. This allows
+    the library to work seamlessly with both OpenGL and DirectX. Probably also works with
+    other graphics APIs too...
+
+    Text rendering is a non-trivial task, and this library strives to make it easy and frictionless.
+
+    This library strives to solve 2 problems:
+    - Creating an individual vertex buffer / textured quad for every single character you
+    want to draw is extremely inefficient - especially if each character has their own
+    texture that needs to be binded to the graphics card.
+    - Every character/glyph has varying sizes and parameters that affect how they should
+    be drawn relative to all the other characters/glyphs. These must be considered when
+    drawing a line of text.
+
+    This library solves these problems by 
+        1.  generating a single, large texture combining all the individual textures of the
+            characters - called a font Texture Atlas
+        2.  generating a single vertex buffer containing the vertices of all the quads 
+            (https://en.wikipedia.org/wiki/Quadrilateral - one quad can draw one character) 
+            required by the text you want to draw
+        3.  handling the assembly of the quad vertices for the single vertex buffer by
+            using the character/glyph metrics (size, offsets, etc.)
+
+CONCEPT:
+    This library serves as a text drawing "canvas". 
+    You can "append" lines of text or characters to the "canvas". You can control where
+    the text gets "appended" to the "canvas" by moving the "cursor" (setting its location
+    on the screen). Then when you want to draw the "canvas" with your graphics API (OpenGL, 
+    DirectX, etc.), you can "grab" the "canvas" (vertex buffer).
+    Then, it is up to you and your graphics API to create the VAO and VBO on the graphics card
+    using the vertex buffer you "grabbed" from this library.
+    Check the USAGE EXAMPLEs below to see how this would translate to code.
+
+USAGE:
+    This library REQUIRES Sean Barrett's stb_truetype.h to be included beforehand:
+    https://raw.githubusercontent.com/nothings/stb/master/stb_truetype.h
+
+    This library's purpose is to return an array of vertices and texture coordinates:
+        [ x, y, u, v, x, y, u, v, ......, x, y, u, v ]
+    You can feed this into a Vertex Buffer with a Stride of 4.
+
+    Since this library only returns an array of vertex and texture coordinates, you 
+    should be able to feed that array into the vertex buffer of any graphics API and 
+    get it working.
+
+    You can also make the library create and return an index buffer if you are using indexed
+    drawing. You don't need to do this if you are not using indexed drawing.
+    See the following links if you don't know what vertex indices or index buffers are:
+    http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-9-vbo-indexing/
+    https://www.learnopengles.com/tag/index-buffer-object/
+
+    This library is not responsible for telling the graphics card to render text. You can
+    do that on your own in your preferred graphics API using the vertex buffer (and index
+    buffer if you enabled index drawing) that this library creates and a quad/ui rendering shader.
+    
+    > Vertex Coordinates:
+        By default, Screen Space coordinates are generated instead of Clip Space coordinates.
+
+        Quick reminder - Screen Space coordinates are where the top left corner of the
+        window/screen is defined as x: 0, y: 0 and the bottom right corner is x: window width,
+        y: window height. Clip Space coordinates are where the top left corner is x: -1, y: 1
+        and the bottom right corner is x: 1, y: -1 (with 0, 0 being the center of the window).
+        (https://learnopengl.com/Getting-started/Coordinate-Systems)
+
+        You can pick which coordinate system to generate vertices for. If you already have an
+        orthographic projection matrix for rendering UI or text, then you can make this library
+        generate Screen Space coordinates and apply the orthographic projection matrix in your
+        UI or text shader. You could also just create an orthographic projection matrix for this
+        text-rendering purpose:
+        https://glm.g-truc.net/0.9.1/api/a00237.html#ga71777a3b1d4fe1729cccf6eda05c8127
+        https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glOrtho.xml
+
+        If you just want to use Clip Space coordinates, then you need to set the flag for it:
+            vtxt_setflags(VTXT_USE_CLIPSPACE_COORDS);
+        and tell the library the window size:
+            vtxt_backbuffersize(WIDTH, HEIGHT);
+        If you are using Screen Space coordinates, you don't need to do any of that.
+
+    > Config Flags:
+        Use the following flags with vtxt_setflags(_flags_):
+        VTXT_CREATE_INDEX_BUFFER:
+            Sets the libary to use indexed vertices and return a index buffer as well when
+            grabbing buffers.
+        VTXT_USE_CLIPSPACE_COORDS:
+            Sets the library to use generate vertices in Clip Space coordinates instead of
+            Screen Space coordinates.
+        VTXT_NEWLINE_ABOVE:
+            Sets the library to move the cursor above the current line instead of below
+            when calling vtxt_new_line.
+        VTXT_FLIP_Y:
+            Flips y vertex position in case you are using a coordinate system where "up" is negative y.
+        VTXT_CREATE_COLOR_BUFFER:
+            Sets the library to also fill a color buffer (one unsigned int per vertex) alongside the
+            vertex buffer. The color written is the one set with vtxt_set_color, or the span color
+            when using vtxt_append_line_spans. Bind it as a separate vertex attribute stream.
+        VTXT_TRACK_DAMAGE:
+            Remembers what every append (and every text block instance) drew this frame and last
+            frame, so vtxt_grab_damage can return the screen rects whose text was added, removed
+            or changed. If your UI is drawn into an offscreen target you can then scissor to those
+            rects and redraw only them; when just a counter changes, only the counter's area is redrawn.
+            The quads are hashed and bounded as they are written, so the vertex output is never read
+            back and VTXT_STREAMING_STORES keeps streaming across appends.
+        VTXT_STREAMING_STORES:
+            For a vertex output that the CPU only writes and never reads, like a persistently mapped
+            (write-combined) GPU buffer set with vtxt_set_vertex_output. Vertices are gathered into
+            64 byte lines (4 x y u v vertices) and each line is written with non-temporal stores in one
+            go, so nothing of the buffer is read into the cache and the write-combining buffers are
+            flushed as whole lines. Lines are the 64 byte aligned cache lines of the buffer wherever it
+            starts, so only the lines at its start and end (and where vtxt_append_line_parallel's chunks
+            meet) are written partially. Only for the x y u v layout in a 16 byte aligned buffer; other
+            buffers are written with normal stores. vtxt_grab_buffer writes out the last partial line and
+            fences, so call it before the GPU reads the buffer. Without SSE2 (or with VTXT_NO_SIMD) the
+            flag does nothing.
+
+    > By Default:
+        - no indexed drawing (unless specified with flag VTXT_CREATE_INDEX_BUFFER)
+        - generates vertices in screenspace coordinates (unless specified with flag VTXT_USE_CLIPSPACE_COORDS)
+        - "next line" is the line below the line we are on (unless specified with flag VTXT_NEWLINE_ABOVE)
+
+    > The following "#define"s are unnecessary but optional:
+        #define VTXT_MAX_CHAR_IN_BUFFER X (before including this library) where X is the
+        maximum number of characters you want to allow in the vertex buffer at once. By default this value
+        is 800 characters. Consider your memory use when setting this value because the memory for the
+        vertex buffer and index buffers are located in the .data segment of the program's alloted memory.
+        Every character increases the combined size of the three buffers (vertex, index, color) by 144 bytes
+        (e.g. 800 characters allocates 800 * 144 = 115200 bytes in the .data segment of memory)
+            e.g. #define VTXT_MAX_CHAR_IN_BUFFER 500
+                 #define VERTEXT_IMPLEMENTATION
+                 #include "vertext.h"
+
+        #define VTXT_ASCII_FROM X and #define VTXT_ASCII_TO Y where X and Y are the start and
+        end ASCII codepoints to collect the font data for. In other words, if X is the character 'a' and Y is
+        the character 'z', then the library will only collect the font data for the ASCII characters from 'a'
+        to 'z'. By default, the start and end codepoints are set to ' ' and '~'.
+            e.g. #define VTXT_ASCII_FROM 'a'
+                 #define VTXT_ASCII_TO 'z'
+                 #define VERTEXT_IMPLEMENTATION
+                 #include "vertext.h"
+
+        #define VTXT_NO_SIMD to disable the SSE2 code paths (they are used automatically when the compiler
+        targets SSE2, e.g. any x64 build) and use the plain C loops instead.
+
+        #define VTXT_BUILTIN_RASTERIZER to rasterize glyphs with this library's own rasterizer instead of
+        stbtt_GetCodepointBitmap. It takes the glyph outlines from stbtt_GetCodepointShape and computes exact
+        area coverage into an accumulation buffer which is then prefix summed (with SSE2 when available), in
+        the style of font-rs. It is noticeably faster than stb_truetype's scanline rasterizer and its output
+        matches it to within a few levels per pixel. bench/vertext_bench.cpp validates and times it.
+
+        #define VTXT_NO_STDIO to compile out everything that touches files (vtxt_save_font, vtxt_load_font,
+        vtxt_dynamic_atlas_prewarm_files, vtxt_save_string_table, vtxt_load_string_table, and the font
+        cache directory). Useful on platforms without stdio.h.
+
+        #define VTXT_STATIC to make function declarations and function definitions static. This makes
+        the implementation private to the source file that creates it. This allows you to have multiple
+        instances of this library in your project without collision. You could use multiple vertex
+        buffers at the same time without clearing the buffers.
+
+    > Font cache:
+        Baking a font (rasterizing every glyph and packing the atlas) is the slowest thing this library
+        does. If you tell the library about a cache directory:
+            vtxt_set_font_cache_directory("cache/fonts");
+        then vtxt_init_font will first look for a cache file named after a hash of the font file bytes
+        and every parameter that affects the bake (font size, ASCII range, atlas width, padding, packer
+        version). On a hit, the glyph metrics and atlas are read from the file and nothing gets rasterized.
+        On a miss, the font is baked as usual and the result is written to the cache directory. The file
+        is written to a temporary file first and then renamed, so a crash or a concurrent process never
+        leaves a half-written cache entry behind. Changing the font file or any bake parameter changes
+        the hash, so stale entries are never used (they just sit there until you delete them).
+        The directory must already exist, and its path must be short enough for the entry's path to fit in
+        1024 bytes (fonts are baked without the cache otherwise). Pass the font file's size with
+        vtxt_init_font_ex so the key hashes exactly the buffer; vtxt_init_font reads the size from the font's
+        table directory and bakes without the cache if the directory looks damaged. You can also save and
+        load fonts explicitly with vtxt_save_font and vtxt_load_font.
+
+    > Atlas compression:
+        Saved fonts (files from vtxt_save_font and font cache entries) store the atlas compressed with a
+        simple run-length codec. Coverage atlases are mostly zeros, so they shrink to a fraction of their
+        size; how much depends on the font and size (bench/vertext_bench.cpp prints the ratio and the
+        decode speed for a font).
+        vtxt_load_font_from_memory loads a saved font from memory, e.g. one embedded in your executable
+        (xxd -i font.vtxf > font_blob.h).
+        The codec is also exposed directly. vtxt_compress_atlas compresses any byte buffer, and the
+        streaming decoder (vtxt_decompress_begin / vtxt_decompress_next / vtxt_decompress_rows) decodes
+        into your destination a piece at a time, e.g. a few rows per call straight into a mapped GPU
+        staging buffer with its own row pitch, without an intermediate copy of the whole atlas.
+
+    > Monospace fonts:
+        vtxt_init_font (and vtxt_load_font) check whether every printable glyph has the same advance and
+        if so set vtxt_font::monospace_advance. Layout and measurement then place glyph i of a line at
+        i * advance instead of looking up and accumulating each glyph's advance, and measuring a line only
+        needs its length.
+
+    > Tabs and tables:
+        vtxt_append_line and vtxt_append_line_spans move the cursor to the next tab stop when they see a
+        '\t'. Tab stops are measured from the x where the line started. By default there is a stop every 4
+        space widths; use vtxt_set_tab_stops to set your own stops (in pixels) and/or the interval used
+        after the last one.
+        For tables, e.g. printing a list of entities or cvars in a console, use vtxt_append_table. It takes
+        text where cells are separated by '\t' and rows by '\n', measures every cell once to find the width
+        of each column, and then emits all cells aligned to their column. This works with proportional
+        fonts, where padding with spaces does not.
+
+    > Text blocks and instancing:
+        When the same string is drawn in many places (e.g. "+10" damage popups), lay it out once with
+        vtxt_make_text_block and then append it as many times as you like with
+        vtxt_append_text_block_instances. Each instance only costs a copy-and-translate of the block's
+        vertices (position, scale, and color per instance) instead of a full layout. Alternatively, upload
+        the block's vertices once and use the vtxt_text_instance array directly as per-instance data for
+        GPU instancing: position = instance.xy + vertex.xy * instance.scale.
+
+    > Search and highlights:
+        For find-as-you-type in a log or console view, vtxt_find_all scans the whole text for a pattern with
+        SSE2 and returns the matches as vtxt_spans. vtxt_append_highlights then draws a colored box behind the
+        matches (or a selection) on the lines the view shows only, before the text is drawn over them. The boxes
+        sample a solid texel every font atlas has, so they go in the same draw call as the text.
+
+    > World labels:
+        Names and health numbers above entities don't need to be projected on the CPU and laid out again every
+        frame. Give your vertex layout an anchor attribute (VTXT_FORMAT_FLOAT32x4 for x y z scale) and
+        lay each label out in Screen Space around the cursor at (0, 0), e.g. with vtxt_append_line_centered,
+        after vtxt_set_anchor(entity world position, scale). Positions are then pixel offsets from the
+        label's anchor and a billboard vertex shader does the projection:
+            vec4 clip = view_projection * vec4(anchor.xyz, 1.0);
+            gl_Position = clip + vec4(position * anchor.w * pixels_to_ndc * clip.w, 0.0, 0.0);
+        (pixels_to_ndc is (2 / width, -2 / height)). Moving the camera changes nothing in the vertices, and
+        when an entity moves, vtxt_move_anchor rewrites only its label's anchors. Lay a label out again
+        only when its text changes.
+
+    > Huge strings:
+        A single multi-megabyte string (e.g. a whole log file) is laid out on one thread by vtxt_append_line.
+        vtxt_append_line_parallel splits it at newlines into chunks, counts the glyphs and lines of every
+        chunk in parallel, and prefix sums them so each chunk knows where its quads go in the vertex buffer
+        and which line it starts on. The chunks are then laid out in parallel straight into place. The
+        output is the same as vtxt_append_line's, vertex for vertex.
+
+    > String tables:
+        Localized UI strings are constant per language, so there is no need to measure them every frame.
+        vtxt_compile_string_table measures every string of a table once (width, height, line count, and
+        where its lines break) for a font, size, and box width. At runtime vtxt_string_table_metrics is a
+        lookup by id and vtxt_append_string_table_entry draws with the stored breaks and tab stops. Tables can
+        be saved (e.g. by a build step) and loaded; loading fails if the font's metrics or the hyphenation
+        changed since. In CI, vtxt_string_table_overflows lists the strings of each language that don't fit
+        their box.
+
+    > Hyphenation:
+        Narrow columns of German or Finnish text wrap badly when long words always move whole to the next line.
+        Compile the TeX hyphenation patterns of the language (hyph-de-1996.tex, hyph-fi.tex, ... from hyph-utf8,
+        the part inside \patterns{...}) with vtxt_init_hyphenator and pass the result to vtxt_set_hyphenator.
+        Paragraph layout then hyphenates the word that overflows a line. Only that word is looked up, and the
+        hyphenator remembers recent words, so wrapping the same text every frame costs about the same as without
+        hyphenation.
+
+    > Dynamic atlas (UTF-8 text):
+        vtxt_font only has the ASCII range baked in. For everything else, set up a vtxt_dynamic_atlas for the
+        same font and lay text out with vtxt_append_line_utf8. Glyphs are looked up by codepoint; a glyph that
+        isn't there yet is recorded as a miss and left out for now. Once per frame, vtxt_dynamic_atlas_resolve
+        rasterizes all the misses (in parallel on your job system if you give it a parallel for), and
+        vtxt_dynamic_atlas_grab_dirty tells you which rows of the atlas texture to upload. Lookups are
+        lock-free and never wait for rasterization, so a burst of new text costs one resolve, not a hitch
+        per glyph.
+        In long sessions glyphs come and go (chat, player names) and the atlas fills up with ones nobody
+        draws anymore. vtxt_dynamic_atlas_evict drops the glyphs that weren't used for a while; they come
+        back on their next lookup. Evicting alone leaves holes, so once atlas->full is set, start a
+        compaction with vtxt_dynamic_atlas_compact_begin: new glyphs go to a fresh texture on the spare
+        page, and every frame vtxt_dynamic_atlas_compact_step moves a few of the live glyphs over and hands
+        you the rects to copy on the GPU. Text laid out after a step picks up the new uvs by itself; for
+        vertices you cached, vtxt_dynamic_atlas_remap rewrites the uvs of the moved glyphs. Nothing stalls:
+        both textures stay valid until the last step.
+        To avoid misses in the first place, hand your string tables to vtxt_dynamic_atlas_prewarm (or
+        vtxt_dynamic_atlas_prewarm_files) while loading.
+
+    > Things to be aware of:
+        - vtxt_font is around ~4KB, so don't copy it around. Just declare it once and then pass around
+          a POINTER to it instead of passing it around by value.
+        - Bytes outside VTXT_ASCII_FROM..VTXT_ASCII_TO draw the font's .notdef glyph (U+FFFD if the font
+          has it), once per UTF-8 sequence, so missing glyphs show up instead of vanishing. Control
+          characters other than '\t' and '\n' draw nothing. For real UTF-8 text see Dynamic atlas.
+
+    > Some types:
+        vtxt_vertex_buffer - see comment at definition - This is what you want to get back from this library
+        vtxt_bitmap - see comment at definition - basically data and pointer to bitmap image in memory
+        vtxt_glyph - see comment at definition - info about specific ASCII glyph
+        vtxt_font - see comment at definition - info about font - HUGE struct
+
+EXAMPLE (Pseudocode):
+
+Do only once:
+    Optional:   vtxt_setflags(VTXT_CREATE_INDEX_BUFFER);                <-- Configures the library with given flags
+                            |
+                            V
+    Optional:   vtxt_backbuffersize(window width=1920, window height=1080);  <-- Only required if using VTXT_USE_CLIPSPACE_COORDS
+                            |
+                            V
+    Required:   vtxt_init_font(font_handle, font_buffer, font_height_px);   <-- DO ONLY ONCE PER FONT (or per font resolution)
+
+Loop:
+    Optional:   vtxt_move_cursor(x = 640, y = 360);                      <-- Set the cursor to x y (where to start drawing)
+                            |
+                            V
+    Required:   vtxt_append_line("some text", font_handle, text_height_px);   <-- text to draw
+                            |
+                            V
+    Optional:   vtxt_new_line(x = 640, font);                            <-- Go to next line, set cursor x to 640
+                            |
+                            V
+    Optional:   vtxt_append_line("next lin", font_handle, text_height_px);    <-- next line to draw
+                            |
+                            V
+    Optional:   vtxt_append_glyph('e', font_handle, text_height_px);          <-- Can append individual glyphs also
+                            |
+                            V
+    Required:   vtxt_vertex_buffer grabbedBuffer = vtxt_grab_buffer();    <-- Grabs the buffer
+                            |
+                            V
+    Required:   * create/bind Vertex Array Object and Vertex Buffer Objects on GPU using your graphics API and grabbedBuffer
+                            |
+                            V
+    Optional:   vtxt_clear_buffer();           <-- REQUIRED IF you want to clear the appended text to append NEW text
+                                                    Only clear AFTER you bind the vertex and index buffers of grabbedBuffer
+                                                    to the VAO and VBO on the GPU.
+
+
+EXAMPLE (C code using OpenGL):
+
+    #define TEXT_SIZE 30
+
+    unsigned char* font_file;
+    // Read the font file on disk (e.g. "arial.ttf") into a byte buffer in memory (e.g. font_file) using your own method
+    // If you are using SDL, you can use SDL_RW. You could also use stdio.h's file operations (fopen, fread, fclose, etc.).
+    
+    vtxt_setflags(VTXT_CREATE_INDEX_BUFFER|VTXT_USE_CLIPSPACE_COORDS);     // vertext.h setting
+    vtxt_backbuffersize(WIDTH, HEIGHT);
+
+    vtxt_font font_handle;
+    vtxt_init_font(&font_handle, font_file, TEXT_SIZE);
+    // TEXT_SIZE in init_font doesn't need to be the same as the TEXT_SIZE we use when we call append_line or glyph
+    // Now font_handle has all the info we need.
+
+    vtxt_clear_buffer();
+    vtxt_move_cursor(100, 100);
+    vtxt_append_line("Hello, world!", &font_handle);
+
+    vtxt_vertex_buffer vb = vtxt_grab_buffer();
+
+    // That's it. That's all you need to interact with this library. Everything below is just
+    // using the vertex buffer from the library to actually get the text drawing in OpenGL.
+
+
+    GLuint VAO_ID, VBO_ID, IBO_ID, TextureID;
+    // Creating the VAO for our text in the GPU memory
+    glBindVertexArray(VAO_ID);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO_ID);
+            glBufferData(GL_ARRAY_BUFFER,
+                         vb.vertices_array_count * 4,
+                         vb.vertex_buffer,
+                         GL_STATIC_DRAW);
+            glEnableVertexAttribArray(0); // vertices coordinates stream
+            glVertexAttribPointer(0, 2, // 2 because vertex is 2 floats (x and y)
+                                  GL_FLOAT, GL_FALSE,
+                                  4*4,  // 4 stride (x y u v) * 4 bytes (size of float)
+                                  0);
+            glEnableVertexAttribArray(1); // texture coordinates stream
+            glVertexAttribPointer(0, 2, // 2 because texture coord is 2 floats (u and v)
+                                  GL_FLOAT, GL_FALSE,
+                                  4*4,  // 4 stride (x y u v) * 4 bytes (size of float)
+                                  2*4); // offset of 8 because two floats, x y, come before u v
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO_ID);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                         vb.indices_array_count * 4,
+                         vb.index_buffer,
+                         GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    // Creating the font texture in GPU memory
+    glGenTextures(1, &TextureID);     
+    glBindTexture(GL_TEXTURE_2D, TextureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,       // for both the target and source format, we can put GL_RED
+                     font_handle.font_atlas.width,   // this just means the bit depth is 1 byte (just the alpha)
+                     font_handle.font_atlas.height, 
+                     0, GL_RED, GL_UNSIGNED_BYTE, 
+                     font_handle.font_atlas.pixels);
+    glActiveTexture(GL_TEXTURE0);
+    // Draw call
+    glUseProgram(SHADER PROGRAM FOR TEXT); // The text shader should use an orthographic projection matrix
+    glBindVertexArray(mesh.id_vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.id_ibo);
+            glDrawElements(GL_TRIANGLES, vb.indices_array_count, GL_UNSIGNED_INT, nullptr);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+TODO:
+    - Signed Distance Fields
+    - Kerning
+    - Top-to-bottom text (vertical text)
+    - Add flag to choose winding order (currently counter-clockwise winding order)
+*/
+#ifndef _INCLUDE_VERTEXT_H_
+#define _INCLUDE_VERTEXT_H_
+
+#include <stddef.h>
+
+#ifndef VTXT_ASCII_FROM
+#define VTXT_ASCII_FROM ' '    // starting ASCII codepoint to collect font data for
+#endif
+#ifndef VTXT_ASCII_TO
+#define VTXT_ASCII_TO '~'      // ending ASCII codepoint to collect font data for
+#endif
+#define VTXT_NOTDEF_GLYPH (VTXT_ASCII_TO - VTXT_ASCII_FROM + 1)   // slot of the glyph drawn for bytes the font doesn't have
+#define VTXT_GLYPH_COUNT (VTXT_ASCII_TO - VTXT_ASCII_FROM + 2)    // ASCII glyphs, then the .notdef glyph
+
+#ifdef VTXT_STATIC
+#define VTXT_DEF static
+#else
+#define VTXT_DEF extern
+#endif
+
+/** Stores a pointer to the vertex buffer assembly array and the count of vertices in the 
+    array (total length of array would be count of vertices * 4).
+*/
+typedef struct vtxt_vertex_buffer
+{
+    int             vertex_count;           // count of vertices in vertex buffer array (4 elements per vertex, so vertices_array_count / 4 = vertex_count)
+    int             vertices_array_count;   // count of elements in vertex buffer array
+    int             indices_array_count;    // count of elements in index buffer array
+    int             colors_array_count;     // count of elements in color buffer array (one per vertex)
+    int             vertex_stride;          // bytes between consecutive vertices (16 unless vtxt_set_vertex_output was given another layout)
+    float*          vertex_buffer;          // pointer to vertex buffer array (your buffer if you called vtxt_set_vertex_output)
+    unsigned int*   index_buffer;           // pointer to index buffer array
+    unsigned int*   color_buffer;           // pointer to color buffer array (NULL unless VTXT_CREATE_COLOR_BUFFER)
+} vtxt_vertex_buffer;
+
+/** vtxt_bitmap is a handle to hold a pointer to an unsigned byte bitmap in memory. Length/count
+    of bitmap elements = width * height.
+*/
+typedef struct vtxt_bitmap
+{
+    int             width;      // bitmap width
+    int             height;     // bitmap height
+    unsigned char*  pixels;     // unsigned byte bitmap
+} vtxt_bitmap;
+
+/** Stores information about a glyph. The glyph is identified via codepoint (ASCII).
+    Check out https://learnopengl.com/img/in-practice/glyph.png 
+    Learn more about glyph metrics if you want.
+*/
+typedef struct vtxt_glyph
+{
+    float           width, height, advance,offset_x,offset_y,min_u,min_v,max_u,max_v;
+    char            codepoint;
+} vtxt_glyph;
+
+/** What a byte of text does in vtxt_font.glyph_map: values below VTXT_GLYPH_ACTION_TAB are glyph slots. */
+enum _vtxt_glyph_action_t
+{
+    VTXT_GLYPH_ACTION_TAB = 253,        // move to the next tab stop
+    VTXT_GLYPH_ACTION_NEWLINE = 254,    // start a new line
+    VTXT_GLYPH_ACTION_SKIP = 255,       // draw nothing (other control characters, UTF-8 continuation bytes)
+};
+
+/** vtxt_font is a handle to hold font information. It's around ~4KB, so don't copy it around all the time.
+*/
+typedef struct vtxt_font
+{
+    int             font_height_px;             // how tall the font's vertical extent is in pixels
+    float           ascender;                   // https://en.wikipedia.org/wiki/Ascender_(typography)
+    float           descender;                  // https://en.wikipedia.org/wiki/Descender
+    float           linegap;                    // gap between the bottom of the descender of one line to the top of the ascender of the line below
+    float           monospace_advance;          // advance shared by every printable glyph if the font is monospace, otherwise 0
+    int             atlas_page;                 // written to the page vertex attribute (see vtxt_vertex_layout). 0 after init, set it to whatever your renderer uses
+    vtxt_bitmap     font_atlas;                 // stores the bitmap for the font texture atlas (https://en.wikipedia.org/wiki/Texture_atlas#/media/File:Texture_Atlas.png)
+    float           solid_u, solid_v;           // uv of a fully covered texel in the atlas, used by highlight quads
+    vtxt_glyph      glyphs[VTXT_GLYPH_COUNT];   // array for glyphs information, the last one is the .notdef glyph
+    unsigned char   glyph_map[256];             // per byte of text, its slot in glyphs or a _vtxt_glyph_action_t
+} vtxt_font;
+
+enum _vtxt_attribute_format_t
+{
+    VTXT_FORMAT_NONE = 0,       // attribute is not written
+    VTXT_FORMAT_FLOAT32x2,      // 2 x float (position, uv)
+    VTXT_FORMAT_UNORM16x2,      // 2 x unsigned short where 0..65535 maps to 0..1 (uv)
+    VTXT_FORMAT_FLOAT32,        // 1 x float (page)
+    VTXT_FORMAT_FLOAT32x4,      // 4 x float RGBA in 0..1 unpacked from the RGBA8 color (color), x y z scale (anchor)
+    VTXT_FORMAT_UINT32,         // 1 x unsigned int (color as packed RGBA8, page)
+    VTXT_FORMAT_UINT16,         // 1 x unsigned short (page)
+    VTXT_FORMAT_UINT8,          // 1 x unsigned char (page)
+    VTXT_FORMAT_FLOAT32x3,      // 3 x float (anchor without the scale)
+};
+
+/** Where one attribute lives inside a vertex: byte offset from the start of the vertex and format. */
+typedef struct vtxt_vertex_attribute
+{
+    int             offset;     // byte offset from the start of the vertex
+    int             format;     // one of _vtxt_attribute_format_t
+} vtxt_vertex_attribute;
+
+/** Describes your own vertex struct so vertices can be written straight into it (see vtxt_set_vertex_output).
+    e.g. for struct ui_vertex { vec2 pos; vec2 uv; u32 color; u16 tex_index; u16 pad; }:
+        vtxt_vertex_layout layout = { sizeof(ui_vertex),
+                                      { offsetof(ui_vertex, pos), VTXT_FORMAT_FLOAT32x2 },
+                                      { offsetof(ui_vertex, uv), VTXT_FORMAT_FLOAT32x2 },
+                                      { offsetof(ui_vertex, color), VTXT_FORMAT_UINT32 },
+                                      { offsetof(ui_vertex, tex_index), VTXT_FORMAT_UINT16 } };
+*/
+typedef struct vtxt_vertex_layout
+{
+    int                     stride;     // bytes from the start of one vertex to the next
+    vtxt_vertex_attribute   position;   // x y
+    vtxt_vertex_attribute   uv;         // texture coordinates into the font atlas
+    vtxt_vertex_attribute   color;      // color set with vtxt_set_color or a span color
+    vtxt_vertex_attribute   page;       // atlas_page of the glyph's font (e.g. a texture array index)
+    vtxt_vertex_attribute   anchor;     // world position and scale set with vtxt_set_anchor (see World labels)
+} vtxt_vertex_layout;
+
+/** A rectangle in screen pixels covering [x0, x1) horizontally and [y0, y1) vertically. */
+typedef struct vtxt_rect
+{
+    int             x0;
+    int             y0;
+    int             x1;
+    int             y1;
+} vtxt_rect;
+
+/** An image in memory that text can be drawn into on the CPU with vtxt_blit_buffer. */
+typedef struct vtxt_image
+{
+    unsigned char*  pixels;     // top row first
+    int             width;      // in pixels
+    int             height;     // in pixels
+    int             stride;     // bytes from the start of one row to the next
+    int             channels;   // 1 (8 bit gray or alpha) or 4 (RGBA8, R in the first byte)
+} vtxt_image;
+
+/** A task the library hands to your job system: call task(task_data, i) for every i in [0, task_count). */
+typedef void (*vtxt_task_fn)(void* task_data, int task_index);
+
+/** Your parallel for. Runs task(task_data, i) for every i in [0, task_count), on as many threads as you
+    like and in any order, and returns when all of them have finished. user_data is passed through. */
+typedef void (*vtxt_parallel_for_fn)(vtxt_task_fn task, void* task_data, int task_count, void* user_data);
+
+/** Glyph cache for codepoints beyond the font's ASCII range (accented letters, Cyrillic, CJK, ...). Glyphs are
+    rasterized on demand into their own atlas texture, which you bind as another page. See vtxt_dynamic_atlas_init.
+    All fields are managed by the library; atlas and page are the ones you read.
+*/
+typedef struct vtxt_dynamic_atlas
+{
+    vtxt_bitmap     atlas;              // single channel, upload the rect from vtxt_dynamic_atlas_grab_dirty when it changes
+    int             page;               // written to the page vertex attribute for glyphs from this atlas, 1 after init
+    int             font_height_px;     // size the glyphs are rasterized at
+    void*           font_info;          // stbtt_fontinfo of the font buffer, which must stay alive
+    float           font_scale;         // stbtt scale for font_height_px
+    int             capacity;           // slots in the glyph table, a power of two
+    int             max_glyphs;         // keys allowed in the table
+    int             key_count;          // keys in the table
+    int*            keys;               // codepoint + 1 per slot, 0 for an empty slot
+    int*            ready;              // per slot, 1 + the live record once the glyph is in the atlas, 0 before, negative once evicted
+    int*            queued;             // per slot, 1 while the glyph waits in misses
+    int*            last_used;          // per slot, frame of the last lookup that found the glyph
+    vtxt_glyph*     glyphs;             // two records per slot, metrics at font_height_px and uvs in atlas
+    int*            glyph_pages;        // page each record's uvs are on
+    int*            misses;             // ring of slots in the order they were requested, -1 until written
+    int             miss_count;         // misses recorded
+    int             miss_resolved;      // misses already handled by vtxt_dynamic_atlas_resolve
+    int             shelf_height;       // row pitch of a new shelf, a bit more than a line of text
+    unsigned long long shelf;           // shelf new glyphs go on: x, y and row pitch packed in 20 bits each
+    int             full;               // 1 once a glyph didn't fit in the atlas
+    vtxt_rect       dirty;              // atlas pixels written since the last vtxt_dynamic_atlas_grab_dirty
+    int             frame;              // count of vtxt_dynamic_atlas_resolve calls
+    int             spare_page;         // page the next compaction packs into, 2 after init
+    int             compacting;         // 1 between vtxt_dynamic_atlas_compact_begin and the last step
+    vtxt_bitmap     old_atlas;          // texture being compacted out of, on old_page
+    int             old_page;
+    int*            compact_slots;      // slots still to be moved, tallest glyph first
+    int             compact_count;
+    int             compact_next;
+} vtxt_dynamic_atlas;
+
+/** A glyph moved by vtxt_dynamic_atlas_compact_step: copy src of the old page's texture to dst of the new one
+    (e.g. glCopyImageSubData), then fix up vertices you kept with vtxt_dynamic_atlas_remap. */
+typedef struct vtxt_atlas_copy
+{
+    vtxt_rect       src;            // pixels in atlas->old_atlas
+    vtxt_rect       dst;            // pixels in atlas->atlas
+    float           old_uv[4];      // min_u, min_v, max_u, max_v before the move
+    float           new_uv[4];      // and after
+} vtxt_atlas_copy;
+
+/** A range of characters [start, start + length) of the text passed to vtxt_append_line_spans
+    that should be drawn with the given color. Spans must be sorted by start and must not overlap.
+    Characters not covered by any span use the color set with vtxt_set_color.
+    color is written verbatim to the color buffer, so it can be a packed RGBA8 color or any other
+    per-glyph value your shader understands (e.g. an index into a palette of styles).
+*/
+typedef struct vtxt_span
+{
+    int             start;      // index of the first character of the span
+    int             length;     // count of characters in the span
+    unsigned int    color;      // value written to the color buffer for the span's vertices
+} vtxt_span;
+
+/** State of a streaming decode of a compressed atlas blob. See vtxt_decompress_begin. */
+typedef struct vtxt_decompress_stream
+{
+    const unsigned char*    src;            // compressed data
+    size_t                  src_size;       // size of compressed data in bytes
+    size_t                  src_pos;        // read position in compressed data
+    size_t                  run_remaining;  // bytes left in the token being decoded
+    int                     run_is_literal; // whether the current token copies bytes from src or fills run_value
+    unsigned char           run_value;      // fill value for repeat and zero tokens
+} vtxt_decompress_stream;
+
+/** A string laid out once by vtxt_make_text_block. The vertices use the same format as the vertex
+    buffer (x y u v) but are always in Screen Space pixels relative to the cursor at (0, 0).
+*/
+typedef struct vtxt_text_block
+{
+    int             vertex_count;   // count of vertices in block (4 elements per vertex)
+    int             index_count;    // count of indices in block (0 unless VTXT_CREATE_INDEX_BUFFER)
+    float*          vertices;       // block vertices, allocated with malloc
+    unsigned int*   indices;        // block indices relative to the first vertex of the block, allocated with malloc
+    int             page;           // atlas_page of the font the block was laid out with
+    int             indexed;        // made with VTXT_CREATE_INDEX_BUFFER: 4 vertices and 6 indices per quad, else 6 vertices
+    struct vtxt_text_block* other_form; // the block converted to the other indexed setting, kept by the first append that needs it
+} vtxt_text_block;
+
+/** Size of a string of a vtxt_string_table, measured when the table was compiled. */
+typedef struct vtxt_string_metrics
+{
+    float           width;          // widest line in pixels
+    float           height;         // line_count lines in pixels
+    int             line_count;
+    int             first_line;     // index of the string's first line in vtxt_string_table.line_breaks
+} vtxt_string_metrics;
+
+/** Strings with their metrics and line breaks for one font and size. See vtxt_compile_string_table. */
+typedef struct vtxt_string_table
+{
+    int                     string_count;
+    int                     text_height_px;
+    int                     box_width_px;       // lines wrap at this width
+    unsigned long long      font_key;           // hash of the glyph metrics and hyphenator the strings were measured with
+    int                     text_size;          // bytes of text
+    char*                   text;               // all strings back to back, each terminated by '\0'
+    int*                    string_offsets;     // per id, where its string starts in text
+    vtxt_string_metrics*    metrics;            // per id
+    int                     line_count;
+    int*                    line_breaks;        // per line, start and end offset in text (spaces at the break excluded)
+    unsigned char*          line_hyphens;       // per line, 1 if a hyphen is drawn after it (see vtxt_set_hyphenator)
+    int                     tab_stop_count;     // the vtxt_set_tab_stops the strings were measured with, drawn with them too
+    int*                    tab_stops;
+    int                     tab_interval;
+} vtxt_string_table;
+
+/** Liang hyphenation patterns compiled into a trie, plus a memo of recently hyphenated words. The trie is
+    laid out breadth first, so the children of a node are contiguous and one step is a scan over a few
+    bytes of labels. See vtxt_init_hyphenator. Change left_min and right_min before hyphenating anything,
+    since the memo keeps the breaks a word got.
+*/
+typedef struct vtxt_hyphenator
+{
+    int                         node_count;     // trie nodes, node 0 is the root
+    unsigned char*              labels;         // per node, the letter on the edge from its parent
+    int*                        first_child;    // per node and one more, children of node n are nodes [first_child[n], first_child[n + 1])
+    int*                        values;         // per node, offset in digits of the pattern that ends there, -1 if none
+    unsigned char*              digits;         // per pattern, its letter count + 1 digits (the digit before each letter, then the last)
+    int                         left_min;       // characters kept before a hyphen, 2 after init
+    int                         right_min;      // characters moved after a hyphen, 2 after init (TeX uses 3 for English)
+    unsigned long long          patterns_hash;  // hash of the patterns it was compiled from, part of string table keys
+    struct _vtxt_hyphen_memo*   memo;           // VTXT_HYPHEN_MEMO_SLOTS words and where they can be hyphenated
+} vtxt_hyphenator;
+
+/** Progress of a layout that is spread over several calls (frames). See vtxt_layout_begin. */
+typedef struct vtxt_layout_state
+{
+    vtxt_text_block block;              // everything laid out so far, drawable at any time (see vtxt_append_text_block_instances)
+    const char*     text;               // text being laid out, must stay alive until the layout is done
+    vtxt_font*      font;
+    int             text_height_px;
+    int             box_width_px;       // lines wrap at this width
+    int             position;           // index of the next character to lay out
+    int             line_end;           // end of the drawable characters of the current line
+    int             hyphen;             // the current line ends with a hyphen that isn't laid out yet
+    int             next_line_start;    // where the line after the current one starts
+    int             cursor_x;           // cursor relative to the block's origin
+    int             cursor_y;
+    int             quad_capacity;      // quads block has memory for
+    int             indexed;            // block has indices (VTXT_CREATE_INDEX_BUFFER was set at vtxt_layout_begin)
+    int             done;               // whole text is laid out
+} vtxt_layout_state;
+
+/** Where and how to draw one copy of a vtxt_text_block. */
+typedef struct vtxt_text_instance
+{
+    float           x;              // cursor x for this copy (Screen Space)
+    float           y;              // cursor y for this copy (Screen Space)
+    float           scale;          // 1.0 draws the block at the size it was laid out at
+    unsigned int    color;          // written to the color buffer if VTXT_CREATE_COLOR_BUFFER
+} vtxt_text_instance;
+
+enum _vtxt_config_flags_t
+{
+    VTXT_CREATE_INDEX_BUFFER     = 1 << 0,
+    VTXT_USE_CLIPSPACE_COORDS    = 1 << 1,
+    VTXT_NEWLINE_ABOVE           = 1 << 2,
+    VTXT_FLIP_Y                  = 1 << 3,
+    VTXT_CREATE_COLOR_BUFFER     = 1 << 4,
+    VTXT_TRACK_DAMAGE            = 1 << 5,
+    VTXT_STREAMING_STORES        = 1 << 6,
+};
+
+/** Configures this library to use the settings defined by _vtxt_config_flags_t.
+    e.g. vtxt_setflags(VTXT_CREATE_INDEX_BUFFER | VTXT_USE_CLIPSPACE_COORDS);
+*/
+VTXT_DEF void vtxt_setflags(int newconfig);
+
+/** ONLY IF YOU WANT CLIPSPACE COORDINATES INSTEAD OF SCREENSPACE COORDINATES
+    Tells vertext.h the size of your application's backbuffer size. If the
+    backbuffer size changes, then you should call this again to update the size.
+*/
+VTXT_DEF void vtxt_backbuffersize(int width, int height);
+
+/** Initializes a vtxt_font font handle to store glyphs information, font information, and the font texture atlas.
+    Collects the glyphs and font information from the font file (given as a binary buffer in memory)
+    and generates the font texture atlas (https://en.wikipedia.org/wiki/Texture_atlas#/media/File:Texture_Atlas.png)
+    Expensive, so you should only do this ONCE per font (and font size) and just keep the vtxt_font around somewhere.
+    font_height_in_pixels := How tall the font's vertical extent (above the baseline) should be in pixels
+*/
+VTXT_DEF void vtxt_init_font(vtxt_font*       font_handle,
+                             unsigned char*   font_buffer,
+                             int              font_height_in_pixels);
+
+/** vtxt_init_font for a font_buffer of font_buffer_size bytes. Only matters with a font cache directory
+    set: the cache key hashes exactly those bytes. vtxt_init_font has to find the file's size in its table
+    directory instead, and skips the cache for a font whose table directory doesn't look sane.
+*/
+VTXT_DEF void vtxt_init_font_ex(vtxt_font*       font_handle,
+                                unsigned char*   font_buffer,
+                                size_t           font_buffer_size,
+                                int              font_height_in_pixels);
+
+/** Set a directory that vtxt_init_font uses to cache baked fonts (see Font cache above).
+    The string is not copied, so keep it alive. Pass NULL to disable the cache (default).
+*/
+VTXT_DEF void vtxt_set_font_cache_directory(const char* directory_path);
+
+/** Write the glyph metrics and font atlas of an initialized font to a file.
+    Returns 1 on success and 0 on failure.
+*/
+VTXT_DEF int vtxt_save_font(const vtxt_font* font_handle,
+                            const char*      file_path);
+
+/** Initialize a font handle from a file written by vtxt_save_font instead of baking it.
+    The atlas pixels are allocated with malloc, same as vtxt_init_font.
+    Returns 1 on success and 0 on failure (missing file, or the file was saved by a build of this
+    library with different VTXT_ASCII_FROM / VTXT_ASCII_TO or an older file format).
+*/
+VTXT_DEF int vtxt_load_font(vtxt_font*  font_handle,
+                            const char* file_path);
+
+/** Initialize a font handle from a saved font in memory (the contents of a file written by vtxt_save_font).
+    Returns 1 on success and 0 on failure.
+*/
+VTXT_DEF int vtxt_load_font_from_memory(vtxt_font*           font_handle,
+                                        const unsigned char* blob,
+                                        size_t               blob_size);
+
+/** Returns the maximum size that vtxt_compress_atlas can produce for src_size bytes of input. */
+VTXT_DEF size_t vtxt_compress_bound(size_t src_size);
+
+/** Compress src (e.g. the pixels of a font atlas) into dst. Returns the compressed size,
+    or 0 if dst_capacity is too small. dst_capacity of vtxt_compress_bound(src_size) always suffices.
+*/
+VTXT_DEF size_t vtxt_compress_atlas(const unsigned char* src,
+                                    size_t               src_size,
+                                    unsigned char*       dst,
+                                    size_t               dst_capacity);
+
+/** Start decoding a compressed blob. The blob must stay alive until decoding is done. */
+VTXT_DEF void vtxt_decompress_begin(vtxt_decompress_stream* stream,
+                                    const unsigned char*    src,
+                                    size_t                  src_size);
+
+/** Decode up to dst_capacity bytes into dst, continuing where the last call stopped.
+    Returns the number of bytes written, which is less than dst_capacity only at the end of the data.
+*/
+VTXT_DEF size_t vtxt_decompress_next(vtxt_decompress_stream* stream,
+                                     unsigned char*          dst,
+                                     size_t                  dst_capacity);
+
+/** Decode row_count rows of row_width bytes into dst, where consecutive rows are dst_row_pitch bytes
+    apart (e.g. a mapped staging buffer with an aligned row pitch). Returns the number of complete rows written.
+*/
+VTXT_DEF int vtxt_decompress_rows(vtxt_decompress_stream* stream,
+                                  unsigned char*          dst,
+                                  int                     row_count,
+                                  int                     row_width,
+                                  int                     dst_row_pitch);
+
+/** Move cursor location (cursor represents the position on the screen where text is placed)
+*/
+VTXT_DEF void vtxt_move_cursor(int x,
+                               int y);
+
+/** Go to new line and set X location of cursor
+*/
+VTXT_DEF void vtxt_new_line(int          x,
+                            vtxt_font*   font,
+                            int          text_height_px);
+
+/** Assemble quads for a line of text and append to vertex buffer.
+    line_of_text is the text you want to draw e.g. "some text I want to Draw".
+    font is the vtxt_font font handle that contains the font you want to use.
+    text_height_px is the desired text height in pixels.
+*/
+VTXT_DEF void vtxt_append_line(const char*   line_of_text,
+                               vtxt_font*    font,
+                               int           text_height_px);
+
+/** Same output as vtxt_append_line, for one huge string (e.g. a log dump). The text is split at '\n' into
+    chunks of about 64KB that are laid out at the same time through parallel_for, each straight into its
+    place in the vertex buffer. Short text, or text that doesn't all fit in the vertex buffer, is laid out
+    by vtxt_append_line on this thread.
+*/
+VTXT_DEF void vtxt_append_line_parallel(const char*          text,
+                                        vtxt_font*           font,
+                                        int                  text_height_px,
+                                        vtxt_parallel_for_fn parallel_for,
+                                        void*                user_data);
+
+/** Same as vtxt_append_line but center horizontally where the cursor is. */
+VTXT_DEF void vtxt_append_line_centered(const char* line_of_text,
+                                        vtxt_font*  font,
+                                        int         text_height_px);
+
+/** Same as vtxt_append_line but with text using right-alignment (the text is to the left of the cursor). */
+VTXT_DEF void vtxt_append_line_align_right(const char* line_of_text, 
+                                           vtxt_font*  font, 
+                                           int         text_height_px);
+
+/** Same as vtxt_append_line but colors the text with out-of-band spans instead of markup in the
+    string. text_length is the count of characters in text to draw. spans must be sorted by start
+    (see vtxt_span). Requires VTXT_CREATE_COLOR_BUFFER to have any visible effect.
+*/
+VTXT_DEF void vtxt_append_line_spans(const char*      text,
+                                     int              text_length,
+                                     vtxt_font*       font,
+                                     int              text_height_px,
+                                     const vtxt_span* spans,
+                                     int              span_count);
+
+/** Finds every occurrence of pattern (pattern_length bytes) in text (text_length bytes), left to right and
+    not overlapping, and writes them to matches_out as spans of the given color, ready for
+    vtxt_append_highlights. Returns the count of matches; only the first max_matches are written.
+    The scan compares the pattern's first and last bytes 16 positions at a time and only checks the whole
+    pattern where both match, so searching a 100MB log on every keystroke stays interactive.
+*/
+VTXT_DEF int vtxt_find_all(const char*  text,
+                           int          text_length,
+                           const char*  pattern,
+                           int          pattern_length,
+                           unsigned int color,
+                           vtxt_span*   matches_out,
+                           int          max_matches);
+
+/** Draws a solid quad in the span's color behind the characters of text covered by spans, e.g. search
+    matches from vtxt_find_all or a selection. Only text[visible_start, visible_end) is walked, laid out like
+    vtxt_append_line(text + visible_start) from the cursor, so pass the lines your view shows; spans before
+    them are skipped with a binary search. The cursor is left where it was: append the same text after this
+    to draw it over its highlights. spans must be sorted by start and must not overlap. The quads sample
+    the font's solid texel, so they are drawn with the font's texture like the text, and need
+    VTXT_CREATE_COLOR_BUFFER (or a color vertex attribute) to be told apart from it.
+*/
+VTXT_DEF void vtxt_append_highlights(const char*      text,
+                                     int              visible_start,
+                                     int              visible_end,
+                                     const vtxt_span* spans,
+                                     int              span_count,
+                                     vtxt_font*       font,
+                                     int              text_height_px);
+
+/** Same as vtxt_append_line but word wraps the text so no line is wider than box_width_px. Lines break
+    at spaces (the spaces at a break aren't drawn) and at '\n'. A word wider than the box is split.
+*/
+VTXT_DEF void vtxt_append_paragraph(const char* text,
+                                    vtxt_font*  font,
+                                    int         text_height_px,
+                                    int         box_width_px);
+
+/** Splits text into pages that fit a box_width_px by box_height_px box, wrapping lines like
+    vtxt_append_paragraph, in a single pass over the text. Writes the character offset where each page
+    starts to page_offsets, followed by the offset where the last page ends (so page_offsets must have
+    room for max_pages + 1 ints), and returns the count of pages. If the text needs more than max_pages
+    pages, pagination stops there and page_offsets[max_pages] is where it stopped: call again on the rest.
+    e.g. int pages[65];
+         int page_count = vtxt_paginate(book_text, &font, 20, 400, 300, pages, 64);
+*/
+VTXT_DEF int vtxt_paginate(const char* text,
+                           vtxt_font*  font,
+                           int         text_height_px,
+                           int         box_width_px,
+                           int         box_height_px,
+                           int*        page_offsets,
+                           int         max_pages);
+
+/** Draws page number page (from 0) of text paginated by vtxt_paginate, starting at the cursor. Only
+    reads that page's characters, so flipping pages costs as much as the page, not the whole text.
+    font, text_height_px and box_width_px must be the ones the text was paginated with.
+*/
+VTXT_DEF void vtxt_append_page(const char* text,
+                               const int*  page_offsets,
+                               int         page,
+                               vtxt_font*  font,
+                               int         text_height_px,
+                               int         box_width_px);
+
+/** Compiles hyphenation patterns in TeX's format (the Liang patterns inside \patterns{...} of the hyph-*.tex
+    files, whitespace separated, e.g. ".ach4 a1b 4b1r") into hyphenator. Letters are compared as bytes, so
+    UTF-8 patterns work as they are. Returns the count of patterns. Free with vtxt_free_hyphenator.
+*/
+VTXT_DEF int vtxt_init_hyphenator(vtxt_hyphenator* hyphenator,
+                                  const char*      patterns);
+
+VTXT_DEF void vtxt_free_hyphenator(vtxt_hyphenator* hyphenator);
+
+/** Writes the offsets in word (word_length bytes of letters, no spaces or punctuation) where a hyphen can go
+    to offsets_out, in order, and returns how many there are (at most max_offsets are written). Words longer
+    than VTXT_MAX_HYPHEN_WORD bytes are not hyphenated.
+*/
+VTXT_DEF int vtxt_hyphenate(vtxt_hyphenator* hyphenator,
+                            const char*      word,
+                            int              word_length,
+                            int*             offsets_out,
+                            int              max_offsets);
+
+/** Hyphenate words that don't fit on their line in vtxt_append_paragraph, vtxt_paginate, vtxt_append_page,
+    vtxt_layout_begin and vtxt_compile_string_table. Only a word that overflows is looked up, and the line
+    breaks at the last hyphenation point that still fits with a '-'. hyphenator must stay alive while it is
+    set; pass NULL (the default) to stop hyphenating.
+*/
+VTXT_DEF void vtxt_set_hyphenator(vtxt_hyphenator* hyphenator);
+
+/** Compiles a string table: copies strings (ids are their indices) and measures each one wrapped at
+    box_width_px like vtxt_append_paragraph (<= 0 for no wrapping), with font at text_height_px. The
+    current linegap offset, tab stops and hyphenator are measured in too; the tab stops are kept in the
+    table and the strings are always drawn with them. Free with vtxt_free_string_table.
+*/
+VTXT_DEF void vtxt_compile_string_table(vtxt_string_table* table,
+                                        const char* const* strings,
+                                        int                string_count,
+                                        vtxt_font*         font,
+                                        int                text_height_px,
+                                        int                box_width_px);
+
+VTXT_DEF void vtxt_free_string_table(vtxt_string_table* table);
+
+/** Returns the pre-measured metrics of string id, or NULL if the table has no such id. */
+VTXT_DEF const vtxt_string_metrics* vtxt_string_table_metrics(const vtxt_string_table* table,
+                                                              int                      id);
+
+/** Returns the text of string id, or NULL if the table has no such id. */
+VTXT_DEF const char* vtxt_string_table_text(const vtxt_string_table* table,
+                                            int                      id);
+
+/** Draws string id from the cursor with its stored line breaks, so no width is measured. Same output as
+    vtxt_append_paragraph with the table's text height and box width. font must be the one the table was
+    compiled with.
+*/
+VTXT_DEF void vtxt_append_string_table_entry(const vtxt_string_table* table,
+                                             int                      id,
+                                             vtxt_font*               font);
+
+/** Finds the strings that don't fit the table's box width (a single word wider than the box) or
+    box_height_px. Writes up to max_ids of their ids to ids_out and returns how many there are in total.
+    e.g. compile each language's table in CI and fail the build if any overflow their UI box.
+*/
+VTXT_DEF int vtxt_string_table_overflows(const vtxt_string_table* table,
+                                         int                      box_height_px,
+                                         int*                     ids_out,
+                                         int                      max_ids);
+
+/** Writes a compiled table to blob and returns its size. If blob is NULL or blob_capacity is too small,
+    only returns the size.
+*/
+VTXT_DEF size_t vtxt_save_string_table_to_memory(const vtxt_string_table* table,
+                                                 unsigned char*           blob,
+                                                 size_t                   blob_capacity);
+
+/** Loads a table written by vtxt_save_string_table_to_memory. Returns 0 if the blob is damaged or was
+    compiled with glyph metrics different from font's (another font, size, or linegap offset) or with
+    another hyphenator than the current one (see vtxt_set_hyphenator), in which case compile it again.
+*/
+VTXT_DEF int vtxt_load_string_table_from_memory(vtxt_string_table*   table,
+                                                const unsigned char* blob,
+                                                size_t               blob_size,
+                                                const vtxt_font*     font);
+
+/** Writes a compiled table to a file. Returns 1 on success and 0 on failure. */
+VTXT_DEF int vtxt_save_string_table(const vtxt_string_table* table,
+                                    const char*              file_path);
+
+/** Loads a table from a file written by vtxt_save_string_table, see vtxt_load_string_table_from_memory. */
+VTXT_DEF int vtxt_load_string_table(vtxt_string_table* table,
+                                    const char*        file_path,
+                                    const vtxt_font*   font);
+
+/** Lay out a line of text once (same as vtxt_append_line with the cursor at 0, 0) and store the
+    result in block instead of the vertex buffer. The vertex buffer is not touched. The block has
+    indices (and block->indexed set) if VTXT_CREATE_INDEX_BUFFER is set. Appending it with the other
+    setting converts it once and keeps the converted copy in block->other_form for later appends.
+    Free the block with vtxt_free_text_block.
+*/
+VTXT_DEF void vtxt_make_text_block(vtxt_text_block* block,
+                                   const char*      text,
+                                   vtxt_font*       font,
+                                   int              text_height_px);
+
+/** Free the memory owned by a block made with vtxt_make_text_block, including its block->other_form. */
+VTXT_DEF void vtxt_free_text_block(vtxt_text_block* block);
+
+/** Append instance_count copies of block to the vertex buffer, each translated, scaled, and colored by
+    its vtxt_text_instance. Copies that don't fit in the vertex buffer are dropped. A block made with the
+    other VTXT_CREATE_INDEX_BUFFER setting than the current one is converted to it on the first such
+    append and the conversion is kept in block->other_form (redone only if the block has grown since, like
+    the block of a vtxt_layout_state that is still being laid out).
+*/
+VTXT_DEF void vtxt_append_text_block_instances(vtxt_text_block*          block,
+                                               const vtxt_text_instance* instances,
+                                               int                       instance_count);
+
+/** Starts laying out text in pieces, so that a huge text can be spread over several frames instead of
+    blowing one frame's budget. Lines wrap at box_width_px like vtxt_append_paragraph (<= 0 for no wrapping,
+    lines then only break at '\n'). Nothing is laid out until vtxt_layout_continue. The output goes to
+    state->block, laid out with the cursor at (0, 0) like vtxt_make_text_block, so the vertex buffer is never
+    touched. Indexed if VTXT_CREATE_INDEX_BUFFER is set now. Free with vtxt_free_text_block(&state->block).
+*/
+VTXT_DEF void vtxt_layout_begin(vtxt_layout_state* state,
+                                const char*         text,
+                                vtxt_font*          font,
+                                int                 text_height_px,
+                                int                 box_width_px);
+
+/** Lays out up to max_glyphs more characters of the text (<= 0 for no limit), stopping early once
+    max_seconds of wall clock time have passed (<= 0 for no limit; measured with a monotonic clock, so
+    other threads and sleeps don't skew it), and carries on from exactly there next time. Returns 1
+    once the whole text is laid out. What is in state->block so far can be drawn in the meantime, e.g.
+        vtxt_layout_continue(&state, 2000, 0.002f);
+        vtxt_append_text_block_instances(&state.block, &where, 1);
+*/
+VTXT_DEF int vtxt_layout_continue(vtxt_layout_state* state,
+                                  int                max_glyphs,
+                                  float              max_seconds);
+
+/** Pulls the next chunk of up to max_quads quads of a layout started with vtxt_layout_begin, for streaming
+    arbitrarily long text through small staging buffers instead of one big vertex buffer. The chunk is
+    written to vertices as x y u v Screen Space floats, which needs room for max_quads * 6 vertices even
+    when indexed, since quads are laid out as triangles first. If the layout is indexed, indices gets
+    max_quads * 6 indices relative to the start of the chunk, and the chunk has 4 vertices per quad
+    instead of 6. Returns the number of quads written, less than max_quads only for the last chunk and 0
+    once the layout is done. Does not touch state->block.
+*/
+VTXT_DEF int vtxt_layout_next_chunk(vtxt_layout_state* state,
+                                    float*             vertices,
+                                    unsigned int*      indices,
+                                    int                max_quads);
+
+#ifdef __cplusplus
+/** One chunk from vtxt_chunk_range. */
+struct vtxt_quad_chunk
+{
+    float*          vertices;
+    unsigned int*   indices;
+    int             quad_count;
+};
+
+/** C++ range over the chunks of vtxt_layout_next_chunk, all pulled into the same caller memory, e.g.
+        vtxt_layout_begin(&state, text, &font, 20, 600);
+        for(const vtxt_quad_chunk& chunk : vtxt_chunk_range(&state, vertices, indices, 1024))
+        {
+            upload(chunk.vertices, chunk.quad_count);
+        }
+*/
+class vtxt_chunk_range
+{
+public:
+    class iterator
+    {
+    public:
+        iterator(vtxt_chunk_range* range)
+            : range(range)
+        {
+        }
+
+        const vtxt_quad_chunk& operator*() const
+        {
+            return range->chunk;
+        }
+
+        const vtxt_quad_chunk* operator->() const
+        {
+            return &range->chunk;
+        }
+
+        iterator& operator++()
+        {
+            range->pull();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return is_end() == other.is_end();
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return is_end() != other.is_end();
+        }
+
+    private:
+        bool is_end() const
+        {
+            return range == 0 || range->chunk.quad_count == 0;
+        }
+
+        vtxt_chunk_range* range;
+    };
+
+    vtxt_chunk_range(vtxt_layout_state* state, float* vertices, unsigned int* indices, int max_quads)
+        : state(state)
+        , max_quads(max_quads)
+    {
+        chunk.vertices = vertices;
+        chunk.indices = indices;
+        chunk.quad_count = 0;
+    }
+
+    iterator begin()
+    {
+        pull();
+        return iterator(this);
+    }
+
+    iterator end()
+    {
+        return iterator(0);
+    }
+
+private:
+    void pull()
+    {
+        chunk.quad_count = vtxt_layout_next_chunk(state, chunk.vertices, chunk.indices, max_quads);
+    }
+
+    vtxt_layout_state*  state;
+    int                 max_quads;
+    vtxt_quad_chunk     chunk;
+};
+#endif
+
+/** Lay out text as a table: cells are separated by '\t' and rows by '\n'. Every column is as wide as
+    its widest cell plus column_gap_px. The table's top-left cell starts at the cursor.
+    Only the first VTXT_MAX_TABLE_COLUMNS columns are aligned; any further cells follow the previous
+    cell with column_gap_px in between.
+*/
+VTXT_DEF void vtxt_append_table(const char* text,
+                                vtxt_font*  font,
+                                int         text_height_px,
+                                int         column_gap_px);
+
+/** Set tab stops used for '\t' in vtxt_append_line and vtxt_append_line_spans. stops_px are
+    sorted distances in pixels from the start of the line (the array is copied, at most
+    VTXT_MAX_TAB_STOPS are used). Past the last stop, stops repeat every interval_px pixels.
+    interval_px <= 0 means 4 space widths of the current font and text height (default).
+    Pass NULL and 0 to only use the interval.
+*/
+VTXT_DEF void vtxt_set_tab_stops(const int* stops_px,
+                                 int        stop_count,
+                                 int        interval_px);
+
+/** Assemble quad for a glyph and append to vertex buffer.
+    font is the vtxt_font font handle that contains the font you want to use.
+    text_height_px is the maximum vertical extent of the glyph in pixels
+*/
+VTXT_DEF void vtxt_append_glyph(const char   in_glyph,
+                                vtxt_font*   font,
+                                int          text_height_px);
+
+/** Get vtxt_vertex_buffer with a pointer to the vertex buffer array
+    and vertex buffer information.
+    With VTXT_STREAMING_STORES, also makes every vertex written so far visible (see Config Flags).
+*/
+VTXT_DEF vtxt_vertex_buffer vtxt_grab_buffer();
+
+/** Call before starting to append new text.
+    Clears the vertex buffer that text is being appended to. 
+    If you called vtxt_grab_buffer and want to use the buffer you received,
+    make sure you pass the buffer to OpenGL (glBufferData) or make a copy of
+    the buffer before calling vtxt_clear_buffer.
+*/
+VTXT_DEF void vtxt_clear_buffer();
+
+/** Draws the text in the vertex buffer into image on the CPU instead of on the GPU. Each glyph quad is
+    alpha blended from font's atlas with its color (the color buffer, the vertex layout's UINT32 color, or
+    the color set with vtxt_set_color, in that order). 1 channel images are blended towards the color's red
+    channel. Quads at the font's native size are copied row by row with SIMD, scaled quads are sampled
+    nearest. Only pixels inside clip (NULL for the whole image) are touched. All quads must be from font.
+    The image is split into bands of rows that can be drawn in parallel: pass your parallel_for (and its
+    user_data) to spread them over threads, or NULL to draw them on the calling thread.
+*/
+VTXT_DEF void vtxt_blit_buffer(const vtxt_font*      font,
+                               vtxt_image*           image,
+                               const vtxt_rect*      clip,
+                               vtxt_parallel_for_fn  parallel_for,
+                               void*                 user_data);
+
+/** With VTXT_TRACK_DAMAGE set: call once per frame after appending all of the frame's text. Writes up to
+    max_rects (at least 1) screen pixel rects to rects_out covering the text that was added, removed or
+    changed since the previous call, and returns how many were written. Only those rects need redrawing.
+    Independent of vtxt_clear_buffer, so it works the same if you clear and grab several times a frame.
+*/
+VTXT_DEF int vtxt_grab_damage(vtxt_rect* rects_out,
+                              int        max_rects);
+
+/** Write vertices straight into your own vertex buffer, in your own vertex format, instead of this
+    library's x y u v vertex buffer. vertex_buffer must hold at least max_vertices vertices of
+    layout->stride bytes each. layout is copied. The index and color buffers are still this library's.
+    Pass NULL for vertex_buffer (or layout) to go back to the default buffer and x y u v format.
+    Clears the vertex buffer.
+*/
+VTXT_DEF void vtxt_set_vertex_output(void*                     vertex_buffer,
+                                     int                       max_vertices,
+                                     const vtxt_vertex_layout* layout);
+
+/** Set the color written to the color buffer for text appended from now on.
+    Used with VTXT_CREATE_COLOR_BUFFER and by vertex layouts with a color attribute.
+    Default is 0xFFFFFFFF (opaque white in RGBA8).
+*/
+VTXT_DEF void vtxt_set_color(unsigned int color);
+
+/** Set the world anchor (x y z) and scale written to the anchor attribute of vertex layouts that have
+    one, for text appended from now on. Default is (0, 0, 0) with scale 1. See World labels.
+*/
+VTXT_DEF void vtxt_set_anchor(float x,
+                              float y,
+                              float z,
+                              float scale);
+
+/** Rewrites the anchor attribute of vertex_count vertices of the vertex output starting at first_vertex,
+    e.g. the vertices of a label whose entity moved. Positions, uvs and everything else stay as they are,
+    and so does the anchor set with vtxt_set_anchor.
+*/
+VTXT_DEF void vtxt_move_anchor(int   first_vertex,
+                               int   vertex_count,
+                               float x,
+                               float y,
+                               float z,
+                               float scale);
+
+/** Set an offset to font linegap. Default is 0. */
+VTXT_DEF void vtxt_set_linegap_offset(float offset);
+
+/** Returns the width and height of the minimum bounding box containing
+    the given text using the given font and text height. Glyphs are placed
+    the way vtxt_append_line places them, tab stops included. */
+VTXT_DEF void vtxt_get_text_bounding_box_info(float* width_out,
+                                              float* height_out,
+                                              const char* text,
+                                              vtxt_font* font,
+                                              int text_height_px);
+
+
+/** Sets up a dynamic atlas for the glyphs of font_buffer that are outside VTXT_ASCII_FROM..VTXT_ASCII_TO.
+    Use the same font buffer and font_height_px as the vtxt_font it goes with; font_buffer must stay alive.
+    The atlas texture is atlas_width x atlas_height and holds up to max_glyphs distinct codepoints.
+    Returns 0 if stb_truetype can't read the font. Free with vtxt_dynamic_atlas_free.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_init(vtxt_dynamic_atlas* atlas,
+                                     unsigned char*      font_buffer,
+                                     int                 font_height_px,
+                                     int                 atlas_width,
+                                     int                 atlas_height,
+                                     int                 max_glyphs);
+
+VTXT_DEF void vtxt_dynamic_atlas_free(vtxt_dynamic_atlas* atlas);
+
+/** Returns codepoint's glyph (metrics at atlas->font_height_px) if it is in the atlas, and writes the page
+    its uvs are on to page_out. Otherwise records a miss and returns NULL; the glyph gets rasterized by the
+    next vtxt_dynamic_atlas_resolve. Lock-free, so any number of threads may call it, also while
+    vtxt_dynamic_atlas_resolve runs. The glyph stays valid until the second resolve or compaction step after.
+*/
+VTXT_DEF const vtxt_glyph* vtxt_dynamic_atlas_glyph(vtxt_dynamic_atlas* atlas,
+                                                    int                 codepoint,
+                                                    int*                page_out);
+
+/** Rasterizes the glyphs that missed since the last call and inserts them into the atlas. Misses are split
+    into tasks of VTXT_MISSES_PER_TASK glyphs and run through parallel_for (NULL to run them on this
+    thread). Tasks claim atlas space for each glyph from a shared shelf with a compare-and-swap, write the
+    bitmap, and only then publish the glyph, so layout on other threads never blocks and never sees a half
+    written glyph. Glyphs that don't fit stay missing and set atlas->full. Call it from one thread at a
+    time, e.g. once per frame after layout; it also advances atlas->frame, the clock of
+    vtxt_dynamic_atlas_evict. Returns the number of glyphs inserted.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_resolve(vtxt_dynamic_atlas*  atlas,
+                                        vtxt_parallel_for_fn parallel_for,
+                                        void*                user_data);
+
+/** If atlas pixels changed since the last call, writes the changed rect to rect_out and returns 1. Upload
+    those rows of atlas->atlas to your texture (e.g. glTexSubImage2D). */
+VTXT_DEF int vtxt_dynamic_atlas_grab_dirty(vtxt_dynamic_atlas* atlas,
+                                           vtxt_rect*          rect_out);
+
+/** Evicts the glyphs no lookup found in the last max_unused_frames resolves. Their atlas space is only
+    reclaimed by the next compaction. Call from the thread that calls vtxt_dynamic_atlas_resolve. Returns
+    the number of glyphs evicted.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_evict(vtxt_dynamic_atlas* atlas,
+                                      int                 max_unused_frames);
+
+/** Starts repacking the atlas. The live glyphs are queued tallest first, atlas->atlas becomes a fresh empty
+    texture on atlas->page (now the spare page), and the old texture stays in atlas->old_atlas on
+    atlas->old_page until compaction ends. Keep both textures bound meanwhile. Returns 0 if a compaction is
+    already running.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_compact_begin(vtxt_dynamic_atlas* atlas);
+
+/** Moves up to max_glyphs queued glyphs into the new texture and writes a copy for each to copies_out.
+    Lookups from then on return the moved glyph on the new page. Glyphs that no longer fit are evicted.
+    After the last glyph the old texture is freed and atlas->compacting cleared; its page is the spare
+    page of the next compaction. Call from the thread that calls vtxt_dynamic_atlas_resolve. Returns the
+    number of copies written.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_compact_step(vtxt_dynamic_atlas* atlas,
+                                             int                 max_glyphs,
+                                             vtxt_atlas_copy*    copies_out);
+
+/** Rewrites the uvs of vertices (x y u v, like vtxt_text_block) that sample a glyph moved by copies to its
+    new place; vertices of other glyphs are left alone. Only pass vertices on the old page, uvs on other
+    pages could match by accident, and switch them to the new page once compaction ends. Costs a sort of
+    the copies plus a binary search per vertex.
+*/
+VTXT_DEF void vtxt_dynamic_atlas_remap(const vtxt_atlas_copy* copies,
+                                       int                    copy_count,
+                                       float*                 vertices,
+                                       int                    vertex_count);
+
+/** Rasterizes every non-ASCII codepoint used in tables (table_sizes[i] bytes of UTF-8 each, e.g. your
+    localization string tables) into the atlas, most frequent first, so that gameplay text never misses.
+    Call it from your loading thread: rasterization goes through parallel_for like
+    vtxt_dynamic_atlas_resolve, and other threads may keep laying out text meanwhile. Don't run it at the
+    same time as vtxt_dynamic_atlas_resolve. Returns the number of glyphs inserted; check atlas->full to
+    see if some didn't fit.
+*/
+VTXT_DEF int vtxt_dynamic_atlas_prewarm(vtxt_dynamic_atlas*  atlas,
+                                        const char* const*   tables,
+                                        const size_t*        table_sizes,
+                                        int                  table_count,
+                                        vtxt_parallel_for_fn parallel_for,
+                                        void*                user_data);
+
+/** vtxt_dynamic_atlas_prewarm on the contents of files. Files that can't be read are skipped. */
+VTXT_DEF int vtxt_dynamic_atlas_prewarm_files(vtxt_dynamic_atlas*  atlas,
+                                              const char* const*   file_paths,
+                                              int                  file_count,
+                                              vtxt_parallel_for_fn parallel_for,
+                                              void*                user_data);
+
+/** Like vtxt_append_line, but text is UTF-8. ASCII characters come from font and everything else from
+    atlas (on the page the glyph is on, see vtxt_dynamic_atlas_glyph). Characters that aren't in the atlas
+    yet are requested and leave a gap as wide as the glyph, so the text doesn't move once they arrive.
+*/
+VTXT_DEF void vtxt_append_line_utf8(const char*         text,
+                                    vtxt_font*          font,
+                                    vtxt_dynamic_atlas* atlas,
+                                    int                 text_height_px);
+
+
+#endif // _INCLUDE_VERTEXT_H_
+
+
+///////////////////// IMPLEMENTATION //////////////////////////
+#ifdef VERTEXT_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+// The two kernel32 timer functions vtxt_layout_continue needs, declared here instead of including
+// windows.h (the declarations match its own, so it can still be included before or after this file)
+union _LARGE_INTEGER;
+#ifdef __cplusplus
+extern "C" {
+#endif
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(union _LARGE_INTEGER* count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(union _LARGE_INTEGER* frequency);
+#ifdef __cplusplus
+}
+#endif
+#elif !defined(CLOCK_MONOTONIC) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/time.h>   // gettimeofday, when strict ISO C modes hide clock_gettime
+#endif
+#ifndef VTXT_NO_STDIO
+#include <stdio.h>
+#if defined(_WIN32)
+#include <process.h>    // _getpid, for font cache temporary file names
+#else
+#include <unistd.h>     // getpid
+#endif
+#endif
+#ifdef VTXT_BUILTIN_RASTERIZER
+#include <math.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if !defined(VTXT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VTXT_SSE2
+#include <emmintrin.h>
+#endif
+
+#define _vtxt_internal static      // vtxt local static variable
+#ifndef VTXT_MAX_CHAR_IN_BUFFER
+#define VTXT_MAX_CHAR_IN_BUFFER 800    // maximum characters allowed in vertex buffer ("canvas")
+#endif
+#define VTXT_MAX_FONT_RESOLUTION 100   // maximum font resolution when initializing font
+#define VTXT_DESIRED_ATLAS_WIDTH 400   // width of the font atlas
+#define VTXT_ATLAS_PAD_X 1                // x padding between the glyph textures on the texture atlas
+#define VTXT_ATLAS_PAD_Y 1                // y padding between the glyph textures on the texture atlas
+#define VTXT_MAX_TAB_STOPS 16           // maximum explicit tab stops set with vtxt_set_tab_stops
+#define VTXT_MAX_FONT_TABLES 256          // most tables vtxt_init_font believes a font directory has
+#define VTXT_MAX_FONT_FILE_SIZE 0x40000000u // largest font file vtxt_init_font believes a table directory about (1 GB)
+#ifndef VTXT_MAX_TABLE_COLUMNS
+#define VTXT_MAX_TABLE_COLUMNS 32       // columns that vtxt_append_table aligns
+#endif
+#define VTXT_BLIT_TILE_ROWS 64            // rows per vtxt_blit_buffer task
+#define VTXT_LAYOUT_SLICE 256             // glyphs vtxt_layout_continue lays out between reading the clock
+#define VTXT_MISSES_PER_TASK 32           // dynamic atlas misses rasterized per vtxt_dynamic_atlas_resolve task
+#define VTXT_LINE_CHUNK_BYTES 65536       // text per vtxt_append_line_parallel task
+#define VTXT_MAX_HYPHEN_WORD 63           // longest word in bytes that gets hyphenated
+#define VTXT_HYPHEN_MEMO_SLOTS 1024       // words a vtxt_hyphenator remembers, a power of two
+#ifndef VTXT_MAX_DAMAGE_BLOCKS
+#define VTXT_MAX_DAMAGE_BLOCKS 256      // appends remembered per frame for VTXT_TRACK_DAMAGE
+#endif
+#define VTXT_ATLAS_PACKER_VERSION 3       // bump when the atlas packing changes so cached fonts get re-baked
+#define VTXT_FONT_FILE_MAGIC 0x46585456   // "VTXF"
+#define VTXT_FONT_FILE_VERSION 4          // 2: atlas is stored compressed, 3: .notdef glyph, 4: solid texel
+#define VTXT_SOLID_BLOCK 3                // side of the fully covered block packed after the glyphs, sampled at its center
+#define VTXT_STRING_TABLE_MAGIC 0x54535456 // "VTST"
+#define VTXT_STRING_TABLE_VERSION 3        // 2: line_hyphens, 3: tab stops
+#ifdef VTXT_BUILTIN_RASTERIZER
+#define VTXT_RASTERIZER_ID 1              // which rasterizer baked the atlas, part of the font cache key
+#else
+#define VTXT_RASTERIZER_ID 0
+#endif
+
+#define _vtxt_ceil(num) ((num) == (float)((int)(num)) ? (int)(num) : (((int)(num)) + 1))
+
+// Buffers for vertices and texture_coords before they are written to GPU memory.
+// If you have a pointer to these buffers, DO NOT let these buffers be overwritten
+// before you bind the data to GPU memory.
+_vtxt_internal float _vtxt_vertex_buffer[VTXT_MAX_CHAR_IN_BUFFER * 6 * 4]; // 800 characters * 6 vertices * (2 xy + 2 uv)
+_vtxt_internal int _vtxt_vertex_count = 0; // Each vertex takes up 4 places in the assembly_buffer
+_vtxt_internal unsigned int _vtxt_index_buffer[VTXT_MAX_CHAR_IN_BUFFER * 6];
+_vtxt_internal int _vtxt_index_count = 0;
+_vtxt_internal unsigned int _vtxt_color_buffer[VTXT_MAX_CHAR_IN_BUFFER * 6]; // one color per vertex
+_vtxt_internal unsigned int _vtxt_color = 0xFFFFFFFF;
+_vtxt_internal float _vtxt_anchor[4] = { 0.f, 0.f, 0.f, 1.f }; // x y z scale
+// Where vertices are written and in what format. By default the x y u v _vtxt_vertex_buffer above.
+_vtxt_internal unsigned char* _vtxt_vertex_output = (unsigned char*) _vtxt_vertex_buffer;
+_vtxt_internal int _vtxt_vertex_capacity = VTXT_MAX_CHAR_IN_BUFFER * 6;
+_vtxt_internal vtxt_vertex_layout _vtxt_layout = { 16, { 0, VTXT_FORMAT_FLOAT32x2 }, { 8, VTXT_FORMAT_FLOAT32x2 }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE } };
+_vtxt_internal int _vtxt_layout_is_default = 1; // layout is tightly packed x y u v floats
+_vtxt_internal int _vtxt_config = 0b0;
+_vtxt_internal float _vtxt_linegap_offset = 0.f;
+_vtxt_internal int _vtxt_cursor_x = 0;   // top left of the screen is pixel (0, 0), bot right of the screen is pixel (screen buffer width, screen buffer height)
+_vtxt_internal int _vtxt_cursor_y = 100; // cursor points to the base line at which to start drawing the glyph
+_vtxt_internal int _vtxt_screen_w_for_clipspace = 800;
+_vtxt_internal int _vtxt_screen_h_for_clipspace = 600;
+_vtxt_internal const char* _vtxt_font_cache_directory = NULL;
+_vtxt_internal int _vtxt_tab_stops[VTXT_MAX_TAB_STOPS];
+_vtxt_internal int _vtxt_tab_stop_count = 0;
+_vtxt_internal vtxt_hyphenator* _vtxt_hyphenator = NULL;
+_vtxt_internal int _vtxt_tab_interval = 0; // <= 0 means 4 space widths
+// VTXT_TRACK_DAMAGE: one block per top-level append, for this frame and the previous one
+typedef struct _vtxt_damage_block
+{
+    unsigned long long  hash;       // hash of the block's quads, see _vtxt_damage_accum
+    vtxt_rect           bounds;     // screen pixel bounds of the block's vertices
+} _vtxt_damage_block;
+_vtxt_internal _vtxt_damage_block _vtxt_damage_blocks[2][VTXT_MAX_DAMAGE_BLOCKS];
+_vtxt_internal int _vtxt_damage_block_count[2] = { 0, 0 };
+_vtxt_internal vtxt_rect _vtxt_damage_overflow[2]; // union of the blocks that didn't fit in _vtxt_damage_blocks
+_vtxt_internal int _vtxt_damage_overflowed[2] = { 0, 0 };
+_vtxt_internal int _vtxt_damage_frame = 0;   // which of the two lists is the current frame
+_vtxt_internal int _vtxt_damage_depth = 0;   // nesting of appends, only the outermost one records a block
+_vtxt_internal int _vtxt_damage_start = 0;   // first vertex of the block being appended
+// What the block being appended has emitted so far, gathered while its quads are written
+typedef struct _vtxt_damage_accum
+{
+    unsigned long long  hash;       // hash of the quads' corners, uvs, page, color and anchor
+    float               min_x;      // screen pixel bounds of the quads
+    float               min_y;
+    float               max_x;
+    float               max_y;
+} _vtxt_damage_accum;
+_vtxt_internal _vtxt_damage_accum _vtxt_damage;
+// VTXT_STREAMING_STORES: the 64 byte aligned line of 4 x y u v vertices being gathered before it is streamed out
+typedef struct _vtxt_stream_gather
+{
+#ifdef VTXT_SSE2
+    __m128      line[4];
+#endif
+    float*      line_dst;       // the cache line the gathered vertices go to, NULL if nothing is gathered
+    int         line_mask;      // which vertices of the line are gathered
+    int         unfenced;       // non-temporal stores were issued since the last fence
+} _vtxt_stream_gather;
+_vtxt_internal _vtxt_stream_gather _vtxt_stream; // the gather of the appends on the calling thread
+
+VTXT_DEF void
+vtxt_setflags(int newconfig)
+{
+    int oldconfig = _vtxt_config;
+    _vtxt_config = newconfig;
+
+    if((oldconfig & VTXT_CREATE_INDEX_BUFFER) != (_vtxt_config & VTXT_CREATE_INDEX_BUFFER))
+    {
+        vtxt_clear_buffer();
+    }
+}
+
+VTXT_DEF void
+vtxt_set_linegap_offset(float offset)
+{
+    _vtxt_linegap_offset = offset;
+}
+
+VTXT_DEF void
+vtxt_set_vertex_output(void* vertex_buffer, int max_vertices, const vtxt_vertex_layout* layout)
+{
+    if(vertex_buffer == NULL || layout == NULL)
+    {
+        vtxt_vertex_layout default_layout = { 16, { 0, VTXT_FORMAT_FLOAT32x2 }, { 8, VTXT_FORMAT_FLOAT32x2 }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE } };
+        _vtxt_vertex_output = (unsigned char*) _vtxt_vertex_buffer;
+        _vtxt_vertex_capacity = VTXT_MAX_CHAR_IN_BUFFER * 6;
+        _vtxt_layout = default_layout;
+    }
+    else
+    {
+        _vtxt_vertex_output = (unsigned char*) vertex_buffer;
+        _vtxt_vertex_capacity = max_vertices;
+        _vtxt_layout = *layout;
+    }
+    _vtxt_layout_is_default = _vtxt_layout.stride == 16
+                              && _vtxt_layout.position.offset == 0 && _vtxt_layout.position.format == VTXT_FORMAT_FLOAT32x2
+                              && _vtxt_layout.uv.offset == 8 && _vtxt_layout.uv.format == VTXT_FORMAT_FLOAT32x2
+                              && _vtxt_layout.color.format == VTXT_FORMAT_NONE
+                              && _vtxt_layout.page.format == VTXT_FORMAT_NONE
+                              && _vtxt_layout.anchor.format == VTXT_FORMAT_NONE
+                              && ((size_t) _vtxt_vertex_output % sizeof(float)) == 0;
+    vtxt_clear_buffer();
+}
+
+VTXT_DEF void
+vtxt_set_color(unsigned int color)
+{
+    _vtxt_color = color;
+}
+
+VTXT_DEF void
+vtxt_set_anchor(float x, float y, float z, float scale)
+{
+    _vtxt_anchor[0] = x;
+    _vtxt_anchor[1] = y;
+    _vtxt_anchor[2] = z;
+    _vtxt_anchor[3] = scale;
+}
+
+VTXT_DEF void
+vtxt_set_tab_stops(const int* stops_px, int stop_count, int interval_px)
+{
+    _vtxt_tab_stop_count = stop_count < VTXT_MAX_TAB_STOPS ? stop_count : VTXT_MAX_TAB_STOPS;
+    for(int i = 0; i < _vtxt_tab_stop_count; ++i)
+    {
+        _vtxt_tab_stops[i] = stops_px[i];
+    }
+    _vtxt_tab_interval = interval_px;
+}
+
+VTXT_DEF void
+vtxt_backbuffersize(int width, int height)
+{
+    _vtxt_screen_w_for_clipspace = width;
+    _vtxt_screen_h_for_clipspace = height;
+}
+
+VTXT_DEF void
+vtxt_set_font_cache_directory(const char* directory_path)
+{
+    _vtxt_font_cache_directory = directory_path;
+}
+
+/** Returns the size in bytes of a TrueType/OpenType font file (or collection) by finding the end
+    of the furthest table in its table directory, for vtxt_init_font which isn't given the buffer length.
+    Returns 0 if the header doesn't look like a font: a wrong tag, more than VTXT_MAX_FONT_TABLES tables
+    or 64 fonts, a directory whose search range doesn't match its table count, or offsets past
+    VTXT_MAX_FONT_FILE_SIZE. Every directory is checked before anything it points to is read, which
+    keeps a damaged font from sending the cache key off to hash gigabytes past the buffer.
+*/
+_vtxt_internal unsigned int
+__private_vtxt_font_file_size(const unsigned char* font_buffer)
+{
+    #define _vtxt_read_u16(p) ((unsigned int)(p)[0] << 8 | (unsigned int)(p)[1])
+    #define _vtxt_read_u32(p) ((unsigned int)(p)[0] << 24 | (unsigned int)(p)[1] << 16 | (unsigned int)(p)[2] << 8 | (unsigned int)(p)[3])
+    unsigned int font_offsets[64];
+    unsigned int font_count = 1;
+    unsigned int file_size = 12;
+    font_offsets[0] = 0;
+    if(memcmp(font_buffer, "ttcf", 4) == 0)
+    {
+        font_count = _vtxt_read_u32(font_buffer + 8);
+        if(font_count == 0 || font_count > 64)
+        {
+            return 0;
+        }
+        for(unsigned int i = 0; i < font_count; ++i)
+        {
+            font_offsets[i] = _vtxt_read_u32(font_buffer + 12 + 4 * i);
+            if(font_offsets[i] > VTXT_MAX_FONT_FILE_SIZE)
+            {
+                return 0;
+            }
+        }
+        file_size = 12 + 4 * font_count;
+    }
+    for(unsigned int i = 0; i < font_count; ++i)
+    {
+        const unsigned char* table_directory = font_buffer + font_offsets[i];
+        unsigned int version = _vtxt_read_u32(table_directory);
+        unsigned int table_count = _vtxt_read_u16(table_directory + 4);
+        unsigned int search_range = 16;
+        while(search_range * 2 <= table_count * 16)
+        {
+            search_range *= 2;
+        }
+        if((version != 0x00010000 && memcmp(table_directory, "OTTO", 4) != 0 && memcmp(table_directory, "true", 4) != 0)
+           || table_count == 0 || table_count > VTXT_MAX_FONT_TABLES || _vtxt_read_u16(table_directory + 6) != search_range)
+        {
+            return 0;
+        }
+        for(unsigned int t = 0; t < table_count; ++t)
+        {
+            const unsigned char* table_record = table_directory + 12 + 16 * t;
+            unsigned int table_offset = _vtxt_read_u32(table_record + 8);
+            unsigned int table_length = _vtxt_read_u32(table_record + 12);
+            if(table_offset > VTXT_MAX_FONT_FILE_SIZE || table_length > VTXT_MAX_FONT_FILE_SIZE - table_offset)
+            {
+                return 0;
+            }
+            if(table_offset + table_length > file_size)
+            {
+                file_size = table_offset + table_length;
+            }
+        }
+    }
+    #undef _vtxt_read_u16
+    #undef _vtxt_read_u32
+    return file_size;
+}
+
+/** 64-bit FNV-1a hash. Pass the previous hash as seed to hash multiple buffers. */
+_vtxt_internal unsigned long long
+__private_vtxt_hash(const void* data, size_t size, unsigned long long seed)
+{
+    const unsigned char* bytes = (const unsigned char*) data;
+    unsigned long long hash = seed;
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/** Cache key for a font bake: the font_size bytes of the font file plus every parameter that affects the result. */
+_vtxt_internal unsigned long long
+__private_vtxt_font_cache_key(const unsigned char* font_buffer, size_t font_size, int font_height_in_pixels)
+{
+    int bake_parameters[] = {
+        font_height_in_pixels,
+        VTXT_ASCII_FROM,
+        VTXT_ASCII_TO,
+        VTXT_DESIRED_ATLAS_WIDTH,
+        VTXT_ATLAS_PAD_X,
+        VTXT_ATLAS_PAD_Y,
+        VTXT_ATLAS_PACKER_VERSION,
+        VTXT_FONT_FILE_VERSION,
+        VTXT_RASTERIZER_ID,
+    };
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    hash = __private_vtxt_hash(font_buffer, font_size, hash);
+    hash = __private_vtxt_hash(bake_parameters, sizeof(bake_parameters), hash);
+    return hash;
+}
+
+/** Sets font_handle->monospace_advance if all printable glyphs share the same advance. */
+_vtxt_internal void
+__private_vtxt_detect_monospace(vtxt_font* font_handle)
+{
+    float advance = -1.f;
+    for(int i = 0; i < VTXT_GLYPH_COUNT; ++i)
+    {
+        vtxt_glyph glyph = font_handle->glyphs[i];
+        if(glyph.codepoint < ' ' || glyph.codepoint > '~')
+        {
+            continue;
+        }
+        if(advance < 0.f)
+        {
+            advance = glyph.advance;
+        }
+        else if(glyph.advance != advance)
+        {
+            font_handle->monospace_advance = 0.f;
+            return;
+        }
+    }
+    font_handle->monospace_advance = advance > 0.f ? advance : 0.f;
+    if(font_handle->monospace_advance > 0.f)
+    {
+        font_handle->glyphs[VTXT_NOTDEF_GLYPH].advance = advance; // takes one cell like everything else
+    }
+}
+
+/** Fills font_handle->glyph_map, so that layout looks every byte up in one table instead of range checking
+    it. Bytes the font has no glyph for draw the .notdef glyph. A UTF-8 sequence draws one .notdef, at its
+    lead byte. */
+_vtxt_internal void
+__private_vtxt_build_glyph_map(vtxt_font* font_handle)
+{
+    for(int byte = 0; byte < 256; ++byte)
+    {
+        if(byte >= VTXT_ASCII_FROM && byte <= VTXT_ASCII_TO)
+        {
+            font_handle->glyph_map[byte] = (unsigned char) (byte - VTXT_ASCII_FROM);
+        }
+        else if(byte == '\t')
+        {
+            font_handle->glyph_map[byte] = VTXT_GLYPH_ACTION_TAB;
+        }
+        else if(byte == '\n')
+        {
+            font_handle->glyph_map[byte] = VTXT_GLYPH_ACTION_NEWLINE;
+        }
+        else if(byte < ' ' || byte == 0x7F || (byte >= 0x80 && byte < 0xC0))
+        {
+            font_handle->glyph_map[byte] = VTXT_GLYPH_ACTION_SKIP;
+        }
+        else
+        {
+            font_handle->glyph_map[byte] = VTXT_NOTDEF_GLYPH;
+        }
+    }
+}
+
+#ifdef VTXT_BUILTIN_RASTERIZER
+/** Adds the signed area coverage of the line p0 -> p1 to the accumulation buffer (font-rs style).
+    Every cell gets the change in coverage from the cell to its left, so a running sum over the
+    whole buffer gives the coverage of each pixel. Coordinates are in bitmap pixels, y down. */
+_vtxt_internal void
+__private_vtxt_raster_line(float* acc, int w, int h, float x0, float y0, float x1, float y1)
+{
+    if(y0 == y1)
+    {
+        return;
+    }
+    float dir = 1.f;
+    if(y0 > y1)
+    {
+        float t;
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+        dir = -1.f;
+    }
+    float dxdy = (x1 - x0) / (y1 - y0);
+    float x = x0;
+    if(y0 < 0.f)
+    {
+        x -= y0 * dxdy;
+    }
+    int y_start = y0 < 0.f ? 0 : (int) y0;
+    int y_end = _vtxt_ceil(y1) < h ? _vtxt_ceil(y1) : h;
+    for(int y = y_start; y < y_end; ++y)
+    {
+        float* row = acc + y * w;
+        float dy = ((float)(y + 1) < y1 ? (float)(y + 1) : y1) - ((float) y > y0 ? (float) y : y0);
+        float x_next = x + dxdy * dy;
+        float d = dy * dir;
+        float xa = x < x_next ? x : x_next;
+        float xb = x < x_next ? x_next : x;
+        // Float error can put an edge a hair outside the bitmap box
+        xa = xa < 0.f ? 0.f : (xa > (float) w ? (float) w : xa);
+        xb = xb < 0.f ? 0.f : (xb > (float) w ? (float) w : xb);
+        float xa_floor = (float)(int) xa;
+        int xa_i = (int) xa;
+        int xb_i = _vtxt_ceil(xb);
+        if(xb_i <= xa_i + 1)
+        {
+            // Edge stays inside one pixel column
+            float x_mid = 0.5f * (x + x_next) - xa_floor;
+            row[xa_i] += d - d * x_mid;
+            row[xa_i + 1] += d * x_mid;
+        }
+        else
+        {
+            float s = 1.f / (xb - xa);
+            float xa_frac = xa - xa_floor;
+            float a0 = 0.5f * s * (1.f - xa_frac) * (1.f - xa_frac);
+            float xb_frac = xb - (float) xb_i + 1.f;
+            float am = 0.5f * s * xb_frac * xb_frac;
+            row[xa_i] += d * a0;
+            if(xb_i == xa_i + 2)
+            {
+                row[xa_i + 1] += d * (1.f - a0 - am);
+            }
+            else
+            {
+                float a1 = s * (1.5f - xa_frac);
+                row[xa_i + 1] += d * (a1 - a0);
+                for(int xi = xa_i + 2; xi < xb_i - 1; ++xi)
+                {
+                    row[xi] += d * s;
+                }
+                float a2 = a1 + (float)(xb_i - xa_i - 3) * s;
+                row[xb_i - 1] += d * (1.f - a2 - am);
+            }
+            row[xb_i] += d * am;
+        }
+        x = x_next;
+    }
+}
+
+/** Number of line segments to flatten a curve into, from the size of its second difference
+    (how far it bends) so that the flattening error stays well under a pixel. */
+_vtxt_internal int
+__private_vtxt_raster_segments(float ddx, float ddy)
+{
+    float dd = ddx * ddx + ddy * ddy;
+    int n = 1 + (int) sqrtf(sqrtf(3.f * sqrtf(dd)));
+    return n < 32 ? n : 32;
+}
+
+/** Prefix sums the accumulation buffer into 8 bit coverage. */
+_vtxt_internal void
+__private_vtxt_raster_accumulate(const float* acc, unsigned char* out, int count)
+{
+    int i = 0;
+    float sum = 0.f;
+#ifdef VTXT_SSE2
+    __m128 running = _mm_setzero_ps();
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 full = _mm_set1_ps(255.f);
+    for(; i + 4 <= count; i += 4)
+    {
+        // In-register prefix sum of 4 cells: [a, a+b, a+b+c, a+b+c+d], then add the running total
+        __m128 x = _mm_loadu_ps(acc + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_shuffle_ps(_mm_setzero_ps(), x, 0x40));
+        x = _mm_add_ps(x, running);
+        running = _mm_shuffle_ps(x, x, 0xFF);
+        __m128 coverage = _mm_min_ps(_mm_and_ps(x, abs_mask), one);
+        __m128i bytes = _mm_cvtps_epi32(_mm_mul_ps(coverage, full));
+        bytes = _mm_packs_epi32(bytes, bytes);
+        bytes = _mm_packus_epi16(bytes, bytes);
+        int packed = _mm_cvtsi128_si32(bytes);
+        memcpy(out + i, &packed, 4);
+    }
+    sum = _mm_cvtss_f32(running);
+#endif
+    for(; i < count; ++i)
+    {
+        sum += acc[i];
+        float coverage = sum < 0.f ? -sum : sum;
+        coverage = coverage < 1.f ? coverage : 1.f;
+        out[i] = (unsigned char)(coverage * 255.f + 0.5f);
+    }
+}
+
+/** Same contract as stbtt_GetCodepointBitmap (scale applies to both axes, returns NULL for an empty
+    glyph, free the result with __private_vtxt_free_glyph_bitmap) but rasterizes the outline from
+    stbtt_GetCodepointShape with exact area coverage into an accumulation buffer. */
+_vtxt_internal unsigned char*
+__private_vtxt_rasterize_codepoint(const stbtt_fontinfo* info, float scale, int codepoint,
+                                   int* width, int* height, int* offset_x, int* offset_y)
+{
+    int ix0, iy0, ix1, iy1;
+    stbtt_GetCodepointBitmapBox(info, codepoint, scale, scale, &ix0, &iy0, &ix1, &iy1);
+    int w = ix1 - ix0;
+    int h = iy1 - iy0;
+    *width = w;
+    *height = h;
+    *offset_x = ix0;
+    *offset_y = iy0;
+    if(w <= 0 || h <= 0)
+    {
+        *width = 0;
+        *height = 0;
+        return NULL;
+    }
+
+    // + 2 cells: an edge on the right border of the last row touches the two cells after it
+    float* acc = (float*) calloc((size_t) w * (size_t) h + 2, sizeof(float));
+    unsigned char* pixels = (unsigned char*) malloc((size_t) w * (size_t) h);
+
+    stbtt_vertex* vertices = NULL;
+    int vertex_count = stbtt_GetCodepointShape(info, codepoint, &vertices);
+    float start_x = 0.f, start_y = 0.f;
+    float pen_x = 0.f, pen_y = 0.f;
+    for(int i = 0; i < vertex_count; ++i)
+    {
+        stbtt_vertex v = vertices[i];
+        // Font units (y up) to bitmap pixels (y down, origin at the top left of the bitmap box)
+        float x = (float) v.x * scale - (float) ix0;
+        float y = -(float) v.y * scale - (float) iy0;
+        if(v.type == STBTT_vmove)
+        {
+            __private_vtxt_raster_line(acc, w, h, pen_x, pen_y, start_x, start_y); // close previous contour
+            start_x = x;
+            start_y = y;
+        }
+        else if(v.type == STBTT_vline)
+        {
+            __private_vtxt_raster_line(acc, w, h, pen_x, pen_y, x, y);
+        }
+        else if(v.type == STBTT_vcurve)
+        {
+            float cx = (float) v.cx * scale - (float) ix0;
+            float cy = -(float) v.cy * scale - (float) iy0;
+            int n = __private_vtxt_raster_segments(pen_x - 2.f * cx + x, pen_y - 2.f * cy + y);
+            float px = pen_x, py = pen_y;
+            for(int s = 1; s <= n; ++s)
+            {
+                float t = (float) s / (float) n;
+                float mt = 1.f - t;
+                float qx = mt * mt * pen_x + 2.f * mt * t * cx + t * t * x;
+                float qy = mt * mt * pen_y + 2.f * mt * t * cy + t * t * y;
+                __private_vtxt_raster_line(acc, w, h, px, py, qx, qy);
+                px = qx;
+                py = qy;
+            }
+        }
+        else if(v.type == STBTT_vcubic)
+        {
+            float c0x = (float) v.cx * scale - (float) ix0;
+            float c0y = -(float) v.cy * scale - (float) iy0;
+            float c1x = (float) v.cx1 * scale - (float) ix0;
+            float c1y = -(float) v.cy1 * scale - (float) iy0;
+            float ddx0 = pen_x - 2.f * c0x + c1x, ddy0 = pen_y - 2.f * c0y + c1y;
+            float ddx1 = c0x - 2.f * c1x + x, ddy1 = c0y - 2.f * c1y + y;
+            int n = ddx0 * ddx0 + ddy0 * ddy0 > ddx1 * ddx1 + ddy1 * ddy1
+                    ? __private_vtxt_raster_segments(ddx0 * 3.f, ddy0 * 3.f)
+                    : __private_vtxt_raster_segments(ddx1 * 3.f, ddy1 * 3.f);
+            float px = pen_x, py = pen_y;
+            for(int s = 1; s <= n; ++s)
+            {
+                float t = (float) s / (float) n;
+                float mt = 1.f - t;
+                float qx = mt * mt * mt * pen_x + 3.f * mt * mt * t * c0x + 3.f * mt * t * t * c1x + t * t * t * x;
+                float qy = mt * mt * mt * pen_y + 3.f * mt * mt * t * c0y + 3.f * mt * t * t * c1y + t * t * t * y;
+                __private_vtxt_raster_line(acc, w, h, px, py, qx, qy);
+                px = qx;
+                py = qy;
+            }
+        }
+        pen_x = x;
+        pen_y = y;
+    }
+    __private_vtxt_raster_line(acc, w, h, pen_x, pen_y, start_x, start_y);
+    stbtt_FreeShape(info, vertices);
+
+    __private_vtxt_raster_accumulate(acc, pixels, w * h);
+    free(acc);
+    return pixels;
+}
+#endif // VTXT_BUILTIN_RASTERIZER
+
+/** Rasterizes one glyph with the rasterizer picked at compile time. Used everywhere a glyph gets
+    rasterized so that VTXT_BUILTIN_RASTERIZER swaps them all. */
+_vtxt_internal unsigned char*
+__private_vtxt_glyph_bitmap(const stbtt_fontinfo* info, float scale, int codepoint,
+                            int* width, int* height, int* offset_x, int* offset_y)
+{
+#ifdef VTXT_BUILTIN_RASTERIZER
+    return __private_vtxt_rasterize_codepoint(info, scale, codepoint, width, height, offset_x, offset_y);
+#else
+    return stbtt_GetCodepointBitmap(info, 0, scale, codepoint, width, height, offset_x, offset_y);
+#endif
+}
+
+_vtxt_internal void
+__private_vtxt_free_glyph_bitmap(unsigned char* bitmap)
+{
+#ifdef VTXT_BUILTIN_RASTERIZER
+    free(bitmap);
+#else
+    stbtt_FreeBitmap(bitmap, 0);
+#endif
+}
+
+_vtxt_internal void
+__private_vtxt_bake_font(vtxt_font* font_handle, unsigned char* font_buffer, int font_height_in_pixels)
+{
+    int desired_atlas_width = VTXT_DESIRED_ATLAS_WIDTH;
+
+    // Font metrics
+    stbtt_fontinfo stb_font_info;
+    stbtt_InitFont(&stb_font_info, font_buffer, 0);
+    float stb_scale = stbtt_ScaleForMappingEmToPixels(&stb_font_info, (float)font_height_in_pixels);
+    int stb_ascender;
+    int stb_descender;
+    int stb_linegap;
+    stbtt_GetFontVMetrics(&stb_font_info, &stb_ascender, &stb_descender, &stb_linegap);
+    font_handle->font_height_px = font_height_in_pixels;
+    font_handle->ascender = (float)stb_ascender * stb_scale;
+    font_handle->descender = (float)stb_descender * stb_scale;
+    font_handle->linegap = (float)stb_linegap * stb_scale;
+
+    // LOAD GLYPH BITMAP AND INFO FOR EVERY CHARACTER WE WANT IN THE FONT
+    vtxt_bitmap temp_glyph_bitmaps[VTXT_GLYPH_COUNT];
+    int tallest_glyph_height = 0;
+    // The .notdef glyph is U+FFFD if the font has it, otherwise the font's own .notdef (glyph 0), which is
+    // what any codepoint the font doesn't map to gets, e.g. the noncharacter U+FFFF
+    int notdef_codepoint = stbtt_FindGlyphIndex(&stb_font_info, 0xFFFD) ? 0xFFFD : 0xFFFF;
+    // load glyph data
+    for(int iter = 0; iter < VTXT_GLYPH_COUNT; ++iter) // ASCII, then .notdef
+    {
+        vtxt_glyph glyph;
+        int codepoint = iter == VTXT_NOTDEF_GLYPH ? notdef_codepoint : VTXT_ASCII_FROM + iter;
+
+        // get glyph metrics from stbtt
+        int stb_advance;
+        int stb_leftbearing;
+        stbtt_GetCodepointHMetrics(&stb_font_info, 
+                                   codepoint, 
+                                   &stb_advance, 
+                                   &stb_leftbearing);
+        glyph.codepoint = iter == VTXT_NOTDEF_GLYPH ? 0 : (char) codepoint;
+        glyph.advance = (float)stb_advance * stb_scale;
+        int stb_width, stb_height;
+        int stb_offset_x, stb_offset_y;
+        unsigned char* stb_bitmap_temp = __private_vtxt_glyph_bitmap(&stb_font_info,
+                                                                     stb_scale,
+                                                                     codepoint,
+                                                                     &stb_width,
+                                                                     &stb_height,
+                                                                     &stb_offset_x,
+                                                                     &stb_offset_y);
+        glyph.width = (float)stb_width;
+        glyph.height = (float)stb_height;
+        glyph.offset_x = (float)stb_offset_x;
+        glyph.offset_y = (float)stb_offset_y;
+
+        // Copy stb_bitmap_temp bitmap into glyph's pixels bitmap so we can free stb_bitmap_temp
+        temp_glyph_bitmaps[iter].pixels = (unsigned char*) calloc((size_t)glyph.width * (size_t)glyph.height, 1);
+        for(int row = 0; row < (int) glyph.height; ++row)
+        {
+            for(int col = 0; col < (int) glyph.width; ++col)
+            {
+                // Flip the bitmap image from top to bottom to bottom to top
+                temp_glyph_bitmaps[iter].pixels[row * (int) glyph.width + col] = stb_bitmap_temp[((int) glyph.height - row - 1) * (int) glyph.width + col];
+            }
+        }
+        temp_glyph_bitmaps[iter].width = (int) glyph.width;
+        temp_glyph_bitmaps[iter].height = (int) glyph.height;
+        if(tallest_glyph_height < (int)glyph.height)
+        {
+            tallest_glyph_height = (int)glyph.height;
+        }
+        __private_vtxt_free_glyph_bitmap(stb_bitmap_temp);
+
+        font_handle->glyphs[iter] = glyph;
+    }
+
+    // Count the rows the packing below needs: the glyphs, then the solid block like one more glyph. A glyph
+    // that doesn't fit at the end of a row wastes the rest of it, so the total width alone can come up short.
+    if(tallest_glyph_height < VTXT_SOLID_BLOCK)
+    {
+        tallest_glyph_height = VTXT_SOLID_BLOCK;
+    }
+    int row_count = 1;
+    int row_x = 0;
+    for(int i = 0; i <= VTXT_GLYPH_COUNT; ++i)
+    {
+        int packed_width = i < VTXT_GLYPH_COUNT ? temp_glyph_bitmaps[i].width : VTXT_SOLID_BLOCK;
+        if(row_x + packed_width > desired_atlas_width)
+        {
+            row_x = 0;
+            ++row_count;
+        }
+        row_x += packed_width + VTXT_ATLAS_PAD_X;
+    }
+    int desired_atlas_height = (tallest_glyph_height + VTXT_ATLAS_PAD_Y) * row_count;
+    // Build font atlas bitmap based on these parameters
+    vtxt_bitmap atlas;
+    atlas.pixels = (unsigned char*) calloc(desired_atlas_width * desired_atlas_height, 1); // TODO avoid calloc here
+    atlas.width = desired_atlas_width;
+    atlas.height = desired_atlas_height;
+    // COMBINE ALL GLYPH BITMAPS INTO FONT ATLAS
+    int glyph_count = VTXT_GLYPH_COUNT;
+    int atlas_x = 0;
+    int atlas_y = 0;
+    for(int i = 0; i < glyph_count; ++i)
+    {
+        vtxt_bitmap glyph_bitmap = temp_glyph_bitmaps[i];
+        if (atlas_x + glyph_bitmap.width > atlas.width) // check if move atlas bitmap cursor to next line
+        {
+            atlas_x = 0;
+            atlas_y += tallest_glyph_height + VTXT_ATLAS_PAD_Y;
+        }
+
+        for(int glyph_y = 0; glyph_y < glyph_bitmap.height; ++glyph_y)
+        {
+            for(int glyph_x = 0; glyph_x < glyph_bitmap.width; ++glyph_x)
+            {
+                atlas.pixels[(atlas_y + glyph_y) * atlas.width + atlas_x + glyph_x]
+                    = glyph_bitmap.pixels[glyph_y * glyph_bitmap.width + glyph_x];
+            }
+        }
+        font_handle->glyphs[i].min_u = (float) atlas_x / (float) atlas.width;
+        font_handle->glyphs[i].min_v = (float) atlas_y / (float) atlas.height;
+        font_handle->glyphs[i].max_u = (float) (atlas_x + glyph_bitmap.width) / (float) atlas.width;
+        font_handle->glyphs[i].max_v = (float) (atlas_y + glyph_bitmap.height) / (float) atlas.height;
+
+        atlas_x += glyph_bitmap.width + VTXT_ATLAS_PAD_X; // move the atlas bitmap cursor by glyph bitmap width
+
+        free(glyph_bitmap.pixels);
+    }
+    if (atlas_x + VTXT_SOLID_BLOCK > atlas.width)
+    {
+        atlas_x = 0;
+        atlas_y += tallest_glyph_height + VTXT_ATLAS_PAD_Y;
+    }
+    for(int solid_y = 0; solid_y < VTXT_SOLID_BLOCK; ++solid_y)
+    {
+        memset(atlas.pixels + (atlas_y + solid_y) * atlas.width + atlas_x, 0xFF, VTXT_SOLID_BLOCK);
+    }
+    font_handle->solid_u = ((float) atlas_x + 0.5f * VTXT_SOLID_BLOCK) / (float) atlas.width;
+    font_handle->solid_v = ((float) atlas_y + 0.5f * VTXT_SOLID_BLOCK) / (float) atlas.height;
+    font_handle->font_atlas = atlas;
+    font_handle->atlas_page = 0;
+    __private_vtxt_detect_monospace(font_handle);
+    __private_vtxt_build_glyph_map(font_handle);
+}
+
+/** Layout of a saved font (file or memory blob). The glyphs and then the compressed atlas follow it. */
+typedef struct _vtxt_font_file_header
+{
+    unsigned int        magic;
+    unsigned int        version;
+    unsigned long long  cache_key;      // 0 when saved explicitly with vtxt_save_font
+    int                 ascii_from;
+    int                 ascii_to;
+    int                 glyph_struct_size;
+    int                 font_height_px;
+    float               ascender;
+    float               descender;
+    float               linegap;
+    int                 atlas_width;
+    int                 atlas_height;
+    float               solid_u;
+    float               solid_v;
+    unsigned int        atlas_compressed_size;
+} _vtxt_font_file_header;
+
+/*  Atlas codec. Coverage atlases are mostly zeros with short runs of glyph pixels, so the
+    stream is a sequence of byte-aligned tokens:
+        0x00-0x3F   literal:    (c & 0x3F) + 1 bytes (1..64) follow
+        0x40-0x7F   repeat:     next byte repeated (c & 0x3F) + 3 times (3..66)
+        0x80-0xBF   zeros:      (c & 0x3F) + 1 zero bytes (1..64)
+        0xC0-0xFF   long zeros: ((c & 0x3F) << 8 | next byte) + 65 zero bytes (65..16448)
+    Decoding is a memset or memcpy per token.
+*/
+VTXT_DEF size_t
+vtxt_compress_bound(size_t src_size)
+{
+    return src_size + src_size / 2 + 2; // worst case: alternating single literals and single zeros
+}
+
+VTXT_DEF size_t
+vtxt_compress_atlas(const unsigned char* src, size_t src_size, unsigned char* dst, size_t dst_capacity)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while(in < src_size)
+    {
+        size_t run = 1;
+        while(in + run < src_size && src[in + run] == src[in] && run < 16448)
+        {
+            ++run;
+        }
+
+        if(src[in] == 0)
+        {
+            if(run <= 64)
+            {
+                if(out + 1 > dst_capacity)
+                {
+                    return 0;
+                }
+                dst[out++] = (unsigned char) (0x80 | (run - 1));
+            }
+            else
+            {
+                if(out + 2 > dst_capacity)
+                {
+                    return 0;
+                }
+                dst[out++] = (unsigned char) (0xC0 | ((run - 65) >> 8));
+                dst[out++] = (unsigned char) ((run - 65) & 0xFF);
+            }
+            in += run;
+        }
+        else if(run >= 3)
+        {
+            run = run > 66 ? 66 : run;
+            if(out + 2 > dst_capacity)
+            {
+                return 0;
+            }
+            dst[out++] = (unsigned char) (0x40 | (run - 3));
+            dst[out++] = src[in];
+            in += run;
+        }
+        else
+        {
+            // Gather literals until a zero or a run worth encoding starts
+            size_t literal_count = 0;
+            while(in + literal_count < src_size && literal_count < 64)
+            {
+                const unsigned char* p = src + in + literal_count;
+                size_t left = src_size - in - literal_count;
+                if(*p == 0 || (left >= 3 && p[1] == p[0] && p[2] == p[0]))
+                {
+                    break;
+                }
+                ++literal_count;
+            }
+            if(out + 1 + literal_count > dst_capacity)
+            {
+                return 0;
+            }
+            dst[out++] = (unsigned char) (literal_count - 1);
+            memcpy(dst + out, src + in, literal_count);
+            out += literal_count;
+            in += literal_count;
+        }
+    }
+    return out;
+}
+
+VTXT_DEF void
+vtxt_decompress_begin(vtxt_decompress_stream* stream, const unsigned char* src, size_t src_size)
+{
+    stream->src = src;
+    stream->src_size = src_size;
+    stream->src_pos = 0;
+    stream->run_remaining = 0;
+    stream->run_is_literal = 0;
+    stream->run_value = 0;
+}
+
+VTXT_DEF size_t
+vtxt_decompress_next(vtxt_decompress_stream* stream, unsigned char* dst, size_t dst_capacity)
+{
+    size_t produced = 0;
+    while(produced < dst_capacity)
+    {
+        if(stream->run_remaining == 0)
+        {
+            if(stream->src_pos >= stream->src_size)
+            {
+                break;
+            }
+            unsigned char token = stream->src[stream->src_pos++];
+            unsigned char operand = stream->src_pos < stream->src_size ? stream->src[stream->src_pos] : 0;
+            stream->run_is_literal = 0;
+            stream->run_value = 0;
+            switch(token >> 6)
+            {
+                case 0:
+                {
+                    stream->run_is_literal = 1;
+                    stream->run_remaining = (size_t) (token & 0x3F) + 1;
+                    if(stream->run_remaining > stream->src_size - stream->src_pos)
+                    {
+                        stream->run_remaining = stream->src_size - stream->src_pos; // truncated blob
+                    }
+                }break;
+                case 1:
+                {
+                    stream->run_value = operand;
+                    stream->run_remaining = (size_t) (token & 0x3F) + 3;
+                    ++stream->src_pos;
+                }break;
+                case 2:
+                {
+                    stream->run_remaining = (size_t) (token & 0x3F) + 1;
+                }break;
+                case 3:
+                {
+                    stream->run_remaining = ((size_t) (token & 0x3F) << 8 | operand) + 65;
+                    ++stream->src_pos;
+                }break;
+            }
+            continue;
+        }
+
+        size_t count = dst_capacity - produced;
+        count = count < stream->run_remaining ? count : stream->run_remaining;
+        if(stream->run_is_literal)
+        {
+            memcpy(dst + produced, stream->src + stream->src_pos, count);
+            stream->src_pos += count;
+        }
+        else
+        {
+            memset(dst + produced, stream->run_value, count);
+        }
+        stream->run_remaining -= count;
+        produced += count;
+    }
+    return produced;
+}
+
+VTXT_DEF int
+vtxt_decompress_rows(vtxt_decompress_stream* stream, unsigned char* dst, int row_count, int row_width, int dst_row_pitch)
+{
+    for(int row = 0; row < row_count; ++row)
+    {
+        if(vtxt_decompress_next(stream, dst + (size_t) row * (size_t) dst_row_pitch, (size_t) row_width) != (size_t) row_width)
+        {
+            return row;
+        }
+    }
+    return row_count;
+}
+
+_vtxt_internal int
+__private_vtxt_parse_font_blob(vtxt_font* font_handle, const unsigned char* blob, size_t blob_size, unsigned long long cache_key)
+{
+    _vtxt_font_file_header header;
+    vtxt_glyph glyphs[VTXT_GLYPH_COUNT];
+    if(blob_size < sizeof(header) + sizeof(glyphs))
+    {
+        return 0;
+    }
+    memcpy(&header, blob, sizeof(header));
+    if(header.magic != VTXT_FONT_FILE_MAGIC
+       || header.version != VTXT_FONT_FILE_VERSION
+       || header.cache_key != cache_key
+       || header.ascii_from != VTXT_ASCII_FROM
+       || header.ascii_to != VTXT_ASCII_TO
+       || header.glyph_struct_size != (int) sizeof(vtxt_glyph)
+       || header.atlas_width <= 0
+       || header.atlas_height <= 0
+       || header.atlas_compressed_size > blob_size - sizeof(header) - sizeof(glyphs))
+    {
+        return 0;
+    }
+    memcpy(glyphs, blob + sizeof(header), sizeof(glyphs));
+
+    size_t atlas_size = (size_t) header.atlas_width * (size_t) header.atlas_height;
+    unsigned char* atlas_pixels = (unsigned char*) malloc(atlas_size);
+    if(atlas_pixels == NULL)
+    {
+        return 0;
+    }
+    vtxt_decompress_stream stream;
+    vtxt_decompress_begin(&stream, blob + sizeof(header) + sizeof(glyphs), header.atlas_compressed_size);
+    if(vtxt_decompress_next(&stream, atlas_pixels, atlas_size) != atlas_size)
+    {
+        free(atlas_pixels);
+        return 0;
+    }
+
+    font_handle->font_height_px = header.font_height_px;
+    font_handle->ascender = header.ascender;
+    font_handle->descender = header.descender;
+    font_handle->linegap = header.linegap;
+    font_handle->font_atlas.width = header.atlas_width;
+    font_handle->font_atlas.height = header.atlas_height;
+    font_handle->font_atlas.pixels = atlas_pixels;
+    font_handle->solid_u = header.solid_u;
+    font_handle->solid_v = header.solid_v;
+    memcpy(font_handle->glyphs, glyphs, sizeof(glyphs));
+    font_handle->atlas_page = 0;
+    __private_vtxt_detect_monospace(font_handle);
+    __private_vtxt_build_glyph_map(font_handle);
+    return 1;
+}
+
+VTXT_DEF int
+vtxt_load_font_from_memory(vtxt_font* font_handle, const unsigned char* blob, size_t blob_size)
+{
+    return __private_vtxt_parse_font_blob(font_handle, blob, blob_size, 0);
+}
+
+#ifndef VTXT_NO_STDIO
+
+_vtxt_internal int
+__private_vtxt_write_font_file(const vtxt_font* font_handle, const char* file_path, unsigned long long cache_key)
+{
+    size_t atlas_size = (size_t) font_handle->font_atlas.width * (size_t) font_handle->font_atlas.height;
+    unsigned char* compressed = (unsigned char*) malloc(vtxt_compress_bound(atlas_size));
+    if(compressed == NULL)
+    {
+        return 0;
+    }
+    size_t compressed_size = vtxt_compress_atlas(font_handle->font_atlas.pixels, atlas_size,
+                                                 compressed, vtxt_compress_bound(atlas_size));
+
+    _vtxt_font_file_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = VTXT_FONT_FILE_MAGIC;
+    header.version = VTXT_FONT_FILE_VERSION;
+    header.cache_key = cache_key;
+    header.ascii_from = VTXT_ASCII_FROM;
+    header.ascii_to = VTXT_ASCII_TO;
+    header.glyph_struct_size = (int) sizeof(vtxt_glyph);
+    header.font_height_px = font_handle->font_height_px;
+    header.ascender = font_handle->ascender;
+    header.descender = font_handle->descender;
+    header.linegap = font_handle->linegap;
+    header.atlas_width = font_handle->font_atlas.width;
+    header.atlas_height = font_handle->font_atlas.height;
+    header.solid_u = font_handle->solid_u;
+    header.solid_v = font_handle->solid_v;
+    header.atlas_compressed_size = (unsigned int) compressed_size;
+
+    FILE* file = fopen(file_path, "wb");
+    if(file == NULL)
+    {
+        free(compressed);
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1
+          && fwrite(font_handle->glyphs, sizeof(font_handle->glyphs), 1, file) == 1
+          && fwrite(compressed, 1, compressed_size, file) == compressed_size;
+    free(compressed);
+    return fclose(file) == 0 && ok;
+}
+
+_vtxt_internal int
+__private_vtxt_read_font_file(vtxt_font* font_handle, const char* file_path, unsigned long long cache_key)
+{
+    FILE* file = fopen(file_path, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* blob = file_size > 0 ? (unsigned char*) malloc((size_t) file_size) : NULL;
+    int ok = blob != NULL && fread(blob, 1, (size_t) file_size, file) == (size_t) file_size;
+    fclose(file);
+
+    ok = ok && __private_vtxt_parse_font_blob(font_handle, blob, (size_t) file_size, cache_key);
+    free(blob);
+    return ok;
+}
+
+VTXT_DEF int
+vtxt_save_font(const vtxt_font* font_handle, const char* file_path)
+{
+    return __private_vtxt_write_font_file(font_handle, file_path, 0);
+}
+
+VTXT_DEF int
+vtxt_load_font(vtxt_font* font_handle, const char* file_path)
+{
+    return __private_vtxt_read_font_file(font_handle, file_path, 0);
+}
+
+#endif // VTXT_NO_STDIO
+
+VTXT_DEF void
+vtxt_init_font(vtxt_font* font_handle, unsigned char* font_buffer, int font_height_in_pixels)
+{
+    size_t font_size = 0;
+#ifndef VTXT_NO_STDIO
+    if(_vtxt_font_cache_directory)
+    {
+        font_size = __private_vtxt_font_file_size(font_buffer); // 0 for an implausible font, which then isn't cached
+    }
+#endif
+    vtxt_init_font_ex(font_handle, font_buffer, font_size, font_height_in_pixels);
+}
+
+VTXT_DEF void
+vtxt_init_font_ex(vtxt_font* font_handle, unsigned char* font_buffer, size_t font_buffer_size, int font_height_in_pixels)
+{
+    if(font_height_in_pixels > VTXT_MAX_FONT_RESOLUTION)
+    {
+        return;
+    }
+
+#ifndef VTXT_NO_STDIO
+    if(_vtxt_font_cache_directory && font_buffer_size > 0)
+    {
+        unsigned long long cache_key = __private_vtxt_font_cache_key(font_buffer, font_buffer_size, font_height_in_pixels);
+        char cache_path[1024];
+        int path_length = snprintf(cache_path, sizeof(cache_path), "%s/vtxt_%016llx.vtxf", _vtxt_font_cache_directory, cache_key);
+        if(path_length >= 0 && path_length < (int) sizeof(cache_path)) // a truncated path names some other file, so don't cache
+        {
+            if(__private_vtxt_read_font_file(font_handle, cache_path, cache_key))
+            {
+                return;
+            }
+
+            __private_vtxt_bake_font(font_handle, font_buffer, font_height_in_pixels);
+
+            // Write to a temporary file then rename so readers never see a partially written entry. The process
+            // id keeps processes apart, the handle address and time keep the fonts of one process apart.
+#if defined(_WIN32)
+            unsigned long long process_id = (unsigned long long) _getpid();
+#else
+            unsigned long long process_id = (unsigned long long) getpid();
+#endif
+            char temp_path[1100];
+            int temp_length = snprintf(temp_path, sizeof(temp_path), "%s.%llx.%p.%llx.tmp", cache_path, process_id,
+                                       (void*) font_handle, (unsigned long long) time(NULL));
+            if(temp_length >= 0 && temp_length < (int) sizeof(temp_path)
+               && (!__private_vtxt_write_font_file(font_handle, temp_path, cache_key) || rename(temp_path, cache_path) != 0))
+            {
+                remove(temp_path); // another process may have written the same entry first, which is fine
+            }
+            return;
+        }
+    }
+#endif
+
+    __private_vtxt_bake_font(font_handle, font_buffer, font_height_in_pixels);
+}
+
+VTXT_DEF void
+vtxt_move_cursor(int x, int y)
+{
+    _vtxt_cursor_x = x;
+    _vtxt_cursor_y = y;
+}
+
+VTXT_DEF void
+vtxt_new_line(int x, vtxt_font* font, int text_height_px)
+{
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    float linegap = font->linegap + _vtxt_linegap_offset;
+    _vtxt_cursor_x = x;
+    if(_vtxt_config & VTXT_NEWLINE_ABOVE)
+    {
+        if(_vtxt_config & VTXT_FLIP_Y)
+        {
+            _vtxt_cursor_y += (int) ((-font->descender + linegap + font->ascender)*scale);
+        }
+        else
+        {
+            _vtxt_cursor_y -= (int) ((-font->descender + linegap + font->ascender)*scale);
+        }
+    }
+    else
+    {
+        if(_vtxt_config & VTXT_FLIP_Y)
+        {
+            _vtxt_cursor_y -= (int) ((-font->descender + linegap + font->ascender)*scale);
+        }
+        else
+        {
+            _vtxt_cursor_y += (int) ((-font->descender + linegap + font->ascender)*scale);
+        }
+    }
+}
+
+/** Writes one vertex attribute value (up to 2 components) in the given format. */
+_vtxt_internal void
+__private_vtxt_write_attribute(unsigned char* dst, int format, float a, float b)
+{
+    switch(format)
+    {
+        case VTXT_FORMAT_FLOAT32x2:
+        {
+            float values[2] = { a, b };
+            memcpy(dst, values, sizeof(values));
+        }break;
+        case VTXT_FORMAT_UNORM16x2:
+        {
+            unsigned short values[2] = { (unsigned short) (a * 65535.f + 0.5f), (unsigned short) (b * 65535.f + 0.5f) };
+            memcpy(dst, values, sizeof(values));
+        }break;
+        case VTXT_FORMAT_FLOAT32:
+        {
+            memcpy(dst, &a, sizeof(a));
+        }break;
+        case VTXT_FORMAT_UINT32:
+        {
+            unsigned int value = (unsigned int) a;
+            memcpy(dst, &value, sizeof(value));
+        }break;
+        case VTXT_FORMAT_UINT16:
+        {
+            unsigned short value = (unsigned short) a;
+            memcpy(dst, &value, sizeof(value));
+        }break;
+        case VTXT_FORMAT_UINT8:
+        {
+            *dst = (unsigned char) a;
+        }break;
+        default:
+        {}break;
+    }
+}
+
+/** Writes anchor (x y z scale) to the anchor attribute of vertex, if the vertex layout has one. */
+_vtxt_internal void
+__private_vtxt_write_anchor(unsigned char* vertex, const float* anchor)
+{
+    if(_vtxt_layout.anchor.format == VTXT_FORMAT_FLOAT32x4)
+    {
+        memcpy(vertex + _vtxt_layout.anchor.offset, anchor, sizeof(float) * 4);
+    }
+    else if(_vtxt_layout.anchor.format == VTXT_FORMAT_FLOAT32x3)
+    {
+        memcpy(vertex + _vtxt_layout.anchor.offset, anchor, sizeof(float) * 3);
+    }
+}
+
+/** Writes one vertex through the current vertex layout. */
+_vtxt_internal void
+__private_vtxt_write_vertex(unsigned char* vertex, float x, float y, float u, float v, unsigned int color, int page)
+{
+    __private_vtxt_write_attribute(vertex + _vtxt_layout.position.offset, _vtxt_layout.position.format, x, y);
+    __private_vtxt_write_attribute(vertex + _vtxt_layout.uv.offset, _vtxt_layout.uv.format, u, v);
+    if(_vtxt_layout.color.format == VTXT_FORMAT_UINT32)
+    {
+        memcpy(vertex + _vtxt_layout.color.offset, &color, sizeof(color)); // packed, not converted from float
+    }
+    else if(_vtxt_layout.color.format == VTXT_FORMAT_FLOAT32x4)
+    {
+        float rgba[4] = { (float) (color & 0xFF) / 255.f, (float) ((color >> 8) & 0xFF) / 255.f,
+                          (float) ((color >> 16) & 0xFF) / 255.f, (float) (color >> 24) / 255.f };
+        memcpy(vertex + _vtxt_layout.color.offset, rgba, sizeof(rgba));
+    }
+    __private_vtxt_write_attribute(vertex + _vtxt_layout.page.offset, _vtxt_layout.page.format, (float) page, 0.f);
+    __private_vtxt_write_anchor(vertex, _vtxt_anchor);
+}
+
+VTXT_DEF void
+vtxt_move_anchor(int first_vertex, int vertex_count, float x, float y, float z, float scale)
+{
+    float anchor[4] = { x, y, z, scale };
+    for(int vertex = first_vertex; vertex < first_vertex + vertex_count && vertex < _vtxt_vertex_count; ++vertex)
+    {
+        __private_vtxt_write_anchor(_vtxt_vertex_output + (size_t) vertex * (size_t) _vtxt_layout.stride, anchor);
+    }
+}
+
+/** Returns whether vertex_count more vertices and index_count more indices fit in the output buffers. */
+_vtxt_internal int
+__private_vtxt_has_room(int vertex_count, int index_count)
+{
+    if(_vtxt_vertex_count + vertex_count > _vtxt_vertex_capacity)
+    {
+        return 0;
+    }
+    if((_vtxt_config & VTXT_CREATE_COLOR_BUFFER) && _vtxt_vertex_count + vertex_count > VTXT_MAX_CHAR_IN_BUFFER * 6)
+    {
+        return 0;
+    }
+    if((_vtxt_config & VTXT_CREATE_INDEX_BUFFER) && _vtxt_index_count + index_count > VTXT_MAX_CHAR_IN_BUFFER * 6)
+    {
+        return 0;
+    }
+    return 1;
+}
+
+/** Returns whether one more quad fits in the output buffers. */
+_vtxt_internal int
+__private_vtxt_has_room_for_quad()
+{
+    return (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) ? __private_vtxt_has_room(4, 6) : __private_vtxt_has_room(6, 0);
+}
+
+/** VTXT_STREAMING_STORES is set and applies to the vertex output: x y u v vertices, 16 byte aligned.
+    Returns the gather the appends on the calling thread stream through, or NULL to write normally. */
+_vtxt_internal _vtxt_stream_gather*
+__private_vtxt_streaming()
+{
+#ifdef VTXT_SSE2
+    int streaming = (_vtxt_config & VTXT_STREAMING_STORES) && _vtxt_layout_is_default && ((size_t) _vtxt_vertex_output % 16) == 0;
+    return streaming ? &_vtxt_stream : NULL;
+#else
+    return NULL;
+#endif
+}
+
+#ifdef VTXT_SSE2
+/** Writes the gathered vertices of the line with non-temporal stores. A whole line leaves the
+    write-combining buffer as one burst; a partial one (only where the output or a parallel chunk starts
+    or ends inside a cache line) doesn't. */
+_vtxt_internal void
+__private_vtxt_stream_line_out(_vtxt_stream_gather* gather)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        if(gather->line_mask & (1 << i))
+        {
+            _mm_stream_ps(gather->line_dst + i * 4, gather->line[i]);
+        }
+    }
+    gather->line_dst = NULL;
+    gather->line_mask = 0;
+    gather->unfenced = 1;
+}
+
+/** Gathers the x y u v vertex into its cache line of the vertex output and streams the line out once
+    all 4 of its vertices are in. Lines are 64 byte aligned in memory, wherever the output starts. */
+_vtxt_internal void
+__private_vtxt_stream_vertex(_vtxt_stream_gather* gather, int vertex, __m128 xyuv)
+{
+    size_t address = (size_t) ((float*) _vtxt_vertex_output + (size_t) vertex * 4);
+    float* dst = (float*) (address & ~(size_t) 63);
+    int slot = (int) (address >> 4) & 3;
+    if(dst != gather->line_dst)
+    {
+        if(gather->line_dst)
+        {
+            __private_vtxt_stream_line_out(gather);
+        }
+        gather->line_dst = dst;
+    }
+    gather->line[slot] = xyuv;
+    gather->line_mask |= 1 << slot;
+    if(gather->line_mask == 0xF)
+    {
+        __private_vtxt_stream_line_out(gather);
+    }
+}
+
+/** Streams count consecutive x y u v vertices starting at vertex. Whole cache lines among them go
+    straight from registers to memory, only the vertices of lines they share with other quads are gathered. */
+_vtxt_internal void
+__private_vtxt_stream_vertices(_vtxt_stream_gather* gather, int vertex, const __m128* xyuv, int count)
+{
+    int i = 0;
+    while(i < count)
+    {
+        float* dst = (float*) _vtxt_vertex_output + (size_t) (vertex + i) * 4;
+        if(((size_t) dst & 63) == 0 && count - i >= 4)
+        {
+            _mm_stream_ps(dst + 0, xyuv[i + 0]);
+            _mm_stream_ps(dst + 4, xyuv[i + 1]);
+            _mm_stream_ps(dst + 8, xyuv[i + 2]);
+            _mm_stream_ps(dst + 12, xyuv[i + 3]);
+            gather->unfenced = 1;
+            i += 4;
+        }
+        else
+        {
+            __private_vtxt_stream_vertex(gather, vertex + i, xyuv[i]);
+            ++i;
+        }
+    }
+}
+#endif
+
+/** Writes out the partial line of gather and fences its non-temporal stores. */
+_vtxt_internal void
+__private_vtxt_flush_gather(_vtxt_stream_gather* gather)
+{
+#ifdef VTXT_SSE2
+    if(gather->line_dst)
+    {
+        __private_vtxt_stream_line_out(gather);
+    }
+    if(gather->unfenced)
+    {
+        _mm_sfence();
+        gather->unfenced = 0;
+    }
+#else
+    (void) gather;
+#endif
+}
+
+/** Makes the vertices written with VTXT_STREAMING_STORES visible to anyone reading the vertex output:
+    writes out the gathered partial line and fences the non-temporal stores. */
+_vtxt_internal void
+__private_vtxt_flush_stores()
+{
+    __private_vtxt_flush_gather(&_vtxt_stream);
+}
+
+_vtxt_internal void
+__private_vtxt_damage_reset(_vtxt_damage_accum* damage)
+{
+    damage->hash = 0xCBF29CE484222325ULL;
+    damage->min_x = 1e30f;
+    damage->min_y = 1e30f;
+    damage->max_x = -1e30f;
+    damage->max_y = -1e30f;
+}
+
+/** Returns where the quads being emitted are gathered for VTXT_TRACK_DAMAGE, NULL when it is off. */
+_vtxt_internal _vtxt_damage_accum*
+__private_vtxt_damage_accum()
+{
+    return (_vtxt_config & VTXT_TRACK_DAMAGE) ? &_vtxt_damage : NULL;
+}
+
+/** Adds word_count 32-bit words to the hash of damage and grows its bounds to (x0, y0) - (x1, y1). The
+    words are mixed a word at a time, FNV-1a style, since this runs for every quad. */
+_vtxt_internal void
+__private_vtxt_damage_add(_vtxt_damage_accum* damage, const unsigned int* words, int word_count,
+                          float x0, float y0, float x1, float y1)
+{
+    unsigned long long hash = damage->hash;
+    for(int i = 0; i < word_count; ++i)
+    {
+        hash ^= words[i];
+        hash *= 0x100000001B3ULL;
+    }
+    damage->hash = hash;
+    damage->min_x = x0 < damage->min_x ? x0 : damage->min_x;
+    damage->min_y = y0 < damage->min_y ? y0 : damage->min_y;
+    damage->max_x = x1 > damage->max_x ? x1 : damage->max_x;
+    damage->max_y = y1 > damage->max_y ? y1 : damage->max_y;
+}
+
+/** Adds everything gathered in from to into, so quads gathered apart (e.g. by the tasks of
+    vtxt_append_line_parallel) can be merged in the order they are in the vertex buffer. */
+_vtxt_internal void
+__private_vtxt_damage_merge(_vtxt_damage_accum* into, const _vtxt_damage_accum* from)
+{
+    unsigned int words[2] = { (unsigned int) from->hash, (unsigned int) (from->hash >> 32) };
+    __private_vtxt_damage_add(into, words, 2, from->min_x, from->min_y, from->max_x, from->max_y);
+}
+
+/** Called at the start of every top-level append. Nested appends (e.g. vtxt_append_line calling
+    vtxt_append_glyph) belong to the outermost one, so only depth 0 -> 1 starts a block. */
+_vtxt_internal void
+__private_vtxt_damage_begin()
+{
+    if(_vtxt_damage_depth++ == 0)
+    {
+        _vtxt_damage_start = _vtxt_vertex_count;
+        __private_vtxt_damage_reset(&_vtxt_damage);
+    }
+}
+
+/** Reads the position of a vertex in the vertex output, in screen pixels even if it was written in Clip Space. */
+_vtxt_internal void
+__private_vtxt_read_position(int vertex, float position[2])
+{
+    memcpy(position, _vtxt_vertex_output + (size_t) vertex * (size_t) _vtxt_layout.stride + _vtxt_layout.position.offset, sizeof(float) * 2);
+    if(_vtxt_config & VTXT_USE_CLIPSPACE_COORDS)
+    {
+        position[0] = (position[0] + 1.f) * 0.5f * (float) _vtxt_screen_w_for_clipspace;
+        position[1] = (1.f - position[1]) * 0.5f * (float) _vtxt_screen_h_for_clipspace;
+    }
+}
+
+_vtxt_internal vtxt_rect
+__private_vtxt_rect_union(vtxt_rect a, vtxt_rect b)
+{
+    vtxt_rect r;
+    r.x0 = a.x0 < b.x0 ? a.x0 : b.x0;
+    r.y0 = a.y0 < b.y0 ? a.y0 : b.y0;
+    r.x1 = a.x1 > b.x1 ? a.x1 : b.x1;
+    r.y1 = a.y1 > b.y1 ? a.y1 : b.y1;
+    return r;
+}
+
+/** Called at the end of every top-level append. Records what the outermost append emitted as one
+    block: the hash gathered while its quads were written, which changes if the text, font, size,
+    position or color changes, and their bounds. Nothing is read back from the vertex output, which
+    may be mapped GPU memory.
+*/
+_vtxt_internal void
+__private_vtxt_damage_end()
+{
+    if(--_vtxt_damage_depth > 0 || !(_vtxt_config & VTXT_TRACK_DAMAGE) || _vtxt_vertex_count == _vtxt_damage_start)
+    {
+        return;
+    }
+    int frame = _vtxt_damage_frame;
+    vtxt_rect bounds;
+    bounds.x0 = (int) _vtxt_damage.min_x - (_vtxt_damage.min_x < (float)(int) _vtxt_damage.min_x);
+    bounds.y0 = (int) _vtxt_damage.min_y - (_vtxt_damage.min_y < (float)(int) _vtxt_damage.min_y);
+    bounds.x1 = (int) _vtxt_damage.max_x + (_vtxt_damage.max_x > (float)(int) _vtxt_damage.max_x);
+    bounds.y1 = (int) _vtxt_damage.max_y + (_vtxt_damage.max_y > (float)(int) _vtxt_damage.max_y);
+    if(_vtxt_damage_block_count[frame] == VTXT_MAX_DAMAGE_BLOCKS)
+    {
+        // Out of blocks: the rest of the frame is tracked as one rect that is always damaged
+        _vtxt_damage_overflow[frame] = _vtxt_damage_overflowed[frame]
+                                       ? __private_vtxt_rect_union(_vtxt_damage_overflow[frame], bounds) : bounds;
+        _vtxt_damage_overflowed[frame] = 1;
+        return;
+    }
+    _vtxt_damage_block* block = &_vtxt_damage_blocks[frame][_vtxt_damage_block_count[frame]++];
+    block->hash = _vtxt_damage.hash;
+    block->bounds = bounds;
+}
+
+/** Writes the quad of a glyph (already scaled to the text height) whose pen position is (pen_x, pen_y)
+    to the vertex buffer at vertex and to the index buffer at index. Touches no other state than stream,
+    the gather the vertices are streamed through (NULL to write them normally, see
+    __private_vtxt_streaming), and damage, where the quad is hashed and bounded for VTXT_TRACK_DAMAGE
+    (NULL when it is off), so workers with their own gathers can write quads of the same buffer at the
+    same time.
+*/
+_vtxt_internal void
+__private_vtxt_emit_glyph_at(vtxt_glyph glyph, float pen_x, float pen_y, int page, int vertex, int index,
+                             _vtxt_stream_gather* stream, _vtxt_damage_accum* damage)
+{
+    float top = pen_y + glyph.offset_y;
+    float bot = pen_y + glyph.offset_y + glyph.height;
+    float left = pen_x + glyph.offset_x;
+    float right = pen_x + glyph.offset_x + glyph.width;
+    if(_vtxt_config & VTXT_FLIP_Y)
+    {
+        top = pen_y - glyph.offset_y;
+        bot = pen_y - glyph.offset_y - glyph.height;
+    }
+
+    if(damage)
+    {
+        // Everything the quad's vertices (and colors) are made of, in screen pixels
+        float quad[8] = { left, top, right, bot, glyph.min_u, glyph.min_v, glyph.max_u, glyph.max_v };
+        float anchor[4] = { 0.f, 0.f, 0.f, 0.f };
+        if(_vtxt_layout.anchor.format != VTXT_FORMAT_NONE)
+        {
+            memcpy(anchor, _vtxt_anchor, sizeof(anchor));
+        }
+        unsigned int words[14];
+        memcpy(words, quad, sizeof(quad));
+        words[8] = (unsigned int) page;
+        words[9] = _vtxt_color;
+        memcpy(words + 10, anchor, sizeof(anchor));
+        __private_vtxt_damage_add(damage, words, 14, left, top < bot ? top : bot, right, top < bot ? bot : top);
+    }
+
+    if(_vtxt_config & VTXT_USE_CLIPSPACE_COORDS)
+    {
+        top = (1.f - ((top / _vtxt_screen_h_for_clipspace) * 2.f));
+        bot = (1.f - ((bot / _vtxt_screen_h_for_clipspace) * 2.f));
+        left = ((left / _vtxt_screen_w_for_clipspace) * 2.f) - 1.f;
+        right = ((right / _vtxt_screen_w_for_clipspace) * 2.f) - 1.f;
+    }
+
+#ifndef VTXT_SSE2
+    (void) stream; // streaming needs SSE2
+#endif
+    int vertices_per_quad = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) ? 4 : 6;
+    if(_vtxt_layout_is_default)
+    {
+        // For each of the vertices, fill in the vertex buffer in the order x y u v
+        int STRIDE = 4;
+        float* out = (float*) _vtxt_vertex_output;
+#ifdef VTXT_SSE2
+        if(stream)
+        {
+            __m128 left_bot = _mm_setr_ps(left, bot, glyph.min_u, glyph.min_v);
+            __m128 left_top = _mm_setr_ps(left, top, glyph.min_u, glyph.max_v);
+            __m128 right_top = _mm_setr_ps(right, top, glyph.max_u, glyph.max_v);
+            __m128 right_bot = _mm_setr_ps(right, bot, glyph.max_u, glyph.min_v);
+            if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
+            {
+                __m128 quad[4] = { left_bot, left_top, right_top, right_bot };
+                __private_vtxt_stream_vertices(stream, vertex, quad, 4);
+            }
+            else
+            {
+                __m128 quad[6] = { left_bot, right_top, left_top, right_bot, right_top, left_bot };
+                __private_vtxt_stream_vertices(stream, vertex, quad, 6);
+            }
+        }
+        else
+#endif
+        if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
+        {
+            out[vertex * STRIDE + 0] = left;
+            out[vertex * STRIDE + 1] = bot;
+            out[vertex * STRIDE + 2] = glyph.min_u;
+            out[vertex * STRIDE + 3] = glyph.min_v;
+
+            out[vertex * STRIDE + 4] = left;
+            out[vertex * STRIDE + 5] = top;
+            out[vertex * STRIDE + 6] = glyph.min_u;
+            out[vertex * STRIDE + 7] = glyph.max_v;
+
+            out[vertex * STRIDE + 8] = right;
+            out[vertex * STRIDE + 9] = top;
+            out[vertex * STRIDE + 10] = glyph.max_u;
+            out[vertex * STRIDE + 11] = glyph.max_v;
+
+            out[vertex * STRIDE + 12] = right;
+            out[vertex * STRIDE + 13] = bot;
+            out[vertex * STRIDE + 14] = glyph.max_u;
+            out[vertex * STRIDE + 15] = glyph.min_v;
+        }
+        else
+        {
+            out[vertex * STRIDE + 0] = left;
+            out[vertex * STRIDE + 1] = bot;
+            out[vertex * STRIDE + 2] = glyph.min_u;
+            out[vertex * STRIDE + 3] = glyph.min_v;
+
+            out[vertex * STRIDE + 4] = right;
+            out[vertex * STRIDE + 5] = top;
+            out[vertex * STRIDE + 6] = glyph.max_u;
+            out[vertex * STRIDE + 7] = glyph.max_v;
+
+            out[vertex * STRIDE + 8] = left;
+            out[vertex * STRIDE + 9] = top;
+            out[vertex * STRIDE + 10] = glyph.min_u;
+            out[vertex * STRIDE + 11] = glyph.max_v;
+
+            out[vertex * STRIDE + 12] = right;
+            out[vertex * STRIDE + 13] = bot;
+            out[vertex * STRIDE + 14] = glyph.max_u;
+            out[vertex * STRIDE + 15] = glyph.min_v;
+
+            out[vertex * STRIDE + 16] = right;
+            out[vertex * STRIDE + 17] = top;
+            out[vertex * STRIDE + 18] = glyph.max_u;
+            out[vertex * STRIDE + 19] = glyph.max_v;
+
+            out[vertex * STRIDE + 20] = left;
+            out[vertex * STRIDE + 21] = bot;
+            out[vertex * STRIDE + 22] = glyph.min_u;
+            out[vertex * STRIDE + 23] = glyph.min_v;
+        }
+    }
+    else
+    {
+        // Corners are left-bot, left-top, right-top, right-bot. Same vertex order as the x y u v path.
+        static const int indexed_order[6] = { 0, 1, 2, 3 };
+        static const int triangles_order[6] = { 0, 2, 1, 3, 2, 0 };
+        const int* order = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) ? indexed_order : triangles_order;
+        float corner_x[4] = { left, left, right, right };
+        float corner_y[4] = { bot, top, top, bot };
+        float corner_u[4] = { glyph.min_u, glyph.min_u, glyph.max_u, glyph.max_u };
+        float corner_v[4] = { glyph.min_v, glyph.max_v, glyph.max_v, glyph.min_v };
+        unsigned char* out = _vtxt_vertex_output + (size_t) vertex * (size_t) _vtxt_layout.stride;
+        for(int i = 0; i < vertices_per_quad; ++i)
+        {
+            int c = order[i];
+            __private_vtxt_write_vertex(out + i * _vtxt_layout.stride, corner_x[c], corner_y[c], corner_u[c], corner_v[c], _vtxt_color, page);
+        }
+    }
+
+    if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
+    {
+        _vtxt_index_buffer[index + 0] = vertex + 0;
+        _vtxt_index_buffer[index + 1] = vertex + 2;
+        _vtxt_index_buffer[index + 2] = vertex + 1;
+        _vtxt_index_buffer[index + 3] = vertex + 0;
+        _vtxt_index_buffer[index + 4] = vertex + 3;
+        _vtxt_index_buffer[index + 5] = vertex + 2;
+    }
+    if(_vtxt_config & VTXT_CREATE_COLOR_BUFFER)
+    {
+        for(int i = 0; i < vertices_per_quad; ++i)
+        {
+            _vtxt_color_buffer[vertex + i] = _vtxt_color;
+        }
+    }
+}
+
+/** Writes the quad of a glyph (already scaled to the text height) whose pen position is (pen_x, pen_y)
+    to the vertex buffer. Does not check capacity and does not move the cursor.
+*/
+_vtxt_internal void
+__private_vtxt_emit_glyph(vtxt_glyph glyph, float pen_x, float pen_y, int page)
+{
+    __private_vtxt_emit_glyph_at(glyph, pen_x, pen_y, page, _vtxt_vertex_count, _vtxt_index_count, __private_vtxt_streaming(),
+                                 __private_vtxt_damage_accum());
+    if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
+    {
+        _vtxt_vertex_count += 4;
+        _vtxt_index_count += 6;
+    }
+    else
+    {
+        _vtxt_vertex_count += 6;
+    }
+}
+
+/** Returns the glyph in slot of font scaled to text_height_px. slot must be a glyph slot, not an action. */
+_vtxt_internal vtxt_glyph
+__private_vtxt_scaled_glyph(int slot, vtxt_font* font, int text_height_px)
+{
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    vtxt_glyph glyph = font->glyphs[slot];
+    glyph.advance *= scale;
+    glyph.width *= scale; // NOTE(Kevin): 2022-06-15 scale was float, but width and height were integers so rounding was causing text to render strangely - fixed by just changing width and height to floats
+    glyph.height *= scale;
+    glyph.offset_x *= scale;
+    glyph.offset_y *= scale;
+    return glyph;
+}
+
+VTXT_DEF void
+__private_vtxt_append_glyph(const char in_glyph, vtxt_font* font, int text_height_px, float x_offset_from_cursor)
+{
+    int slot = font->glyph_map[(unsigned char) in_glyph];
+    if(slot >= VTXT_GLYPH_ACTION_TAB) // Control characters are up to the caller
+    {
+        return;
+    }
+
+    if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+    {
+        return;
+    }
+
+    vtxt_glyph glyph = __private_vtxt_scaled_glyph(slot, font, text_height_px);
+    __private_vtxt_emit_glyph(glyph, (float) _vtxt_cursor_x + x_offset_from_cursor, (float) _vtxt_cursor_y, font->atlas_page);
+
+    // Advance the cursor
+    _vtxt_cursor_x += (int) glyph.advance;
+}
+
+/** Returns how far the cursor moves in pixels after drawing the glyph (0 for control characters). */
+_vtxt_internal int
+__private_vtxt_glyph_advance(char in_glyph, vtxt_font* font, int text_height_px)
+{
+    int slot = font->glyph_map[(unsigned char) in_glyph];
+    if(slot >= VTXT_GLYPH_ACTION_TAB)
+    {
+        return 0;
+    }
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    return (int) (font->glyphs[slot].advance * scale);
+}
+
+/** Returns the first tab stop after x. Both are relative to the start of the line. */
+_vtxt_internal int
+__private_vtxt_next_tab_stop(int x, vtxt_font* font, int text_height_px)
+{
+    for(int i = 0; i < _vtxt_tab_stop_count; ++i)
+    {
+        if(_vtxt_tab_stops[i] > x)
+        {
+            return _vtxt_tab_stops[i];
+        }
+    }
+    int interval = _vtxt_tab_interval > 0 ? _vtxt_tab_interval : 4 * __private_vtxt_glyph_advance(' ', font, text_height_px);
+    if(interval <= 0)
+    {
+        return x;
+    }
+    int last_stop = _vtxt_tab_stop_count > 0 ? _vtxt_tab_stops[_vtxt_tab_stop_count - 1] : 0;
+    if(x < last_stop)
+    {
+        x = last_stop;
+    }
+    return last_stop + ((x - last_stop) / interval + 1) * interval;
+}
+
+/** Moves the cursor to the next tab stop after the cursor. Stops are relative to line_start_x. */
+_vtxt_internal void
+__private_vtxt_tab(int line_start_x, vtxt_font* font, int text_height_px)
+{
+    _vtxt_cursor_x = line_start_x + __private_vtxt_next_tab_stop(_vtxt_cursor_x - line_start_x, font, text_height_px);
+}
+
+/** Returns how far the cursor moves after in_glyph when it is x pixels from the start of the line: to the
+    next tab stop for a tab (like vtxt_append_line), else the glyph's advance. */
+_vtxt_internal int
+__private_vtxt_advance_at(char in_glyph, int x, vtxt_font* font, int text_height_px)
+{
+    if(font->glyph_map[(unsigned char) in_glyph] == VTXT_GLYPH_ACTION_TAB)
+    {
+        return __private_vtxt_next_tab_stop(x, font, text_height_px) - x;
+    }
+    return __private_vtxt_glyph_advance(in_glyph, font, text_height_px);
+}
+
+VTXT_DEF void
+vtxt_append_glyph(const char in_glyph, vtxt_font* font, int text_height_px)
+{
+    __private_vtxt_damage_begin();
+    __private_vtxt_append_glyph(in_glyph, font, text_height_px, 0.f);
+    __private_vtxt_damage_end();
+}
+
+/** vtxt_append_line for monospace fonts. Glyph i after the cursor is at cursor x + i * advance, so
+    there is no per-glyph advance lookup and no per-glyph cursor update.
+*/
+_vtxt_internal void
+__private_vtxt_append_line_monospace(const char* line_of_text, vtxt_font* font, int text_height_px)
+{
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    int advance = (int) (font->monospace_advance * scale);
+    int line_start_x = _vtxt_cursor_x;
+    int glyphs_since_cursor = 0;
+    for(; *line_of_text != '\0'; ++line_of_text)
+    {
+        int slot = font->glyph_map[(unsigned char) *line_of_text];
+        if(slot == VTXT_GLYPH_ACTION_TAB || slot == VTXT_GLYPH_ACTION_NEWLINE)
+        {
+            _vtxt_cursor_x += glyphs_since_cursor * advance;
+            glyphs_since_cursor = 0;
+            if(slot == VTXT_GLYPH_ACTION_TAB)
+            {
+                __private_vtxt_tab(line_start_x, font, text_height_px);
+            }
+            else
+            {
+                vtxt_new_line(line_start_x, font, text_height_px);
+            }
+        }
+        else if(slot < VTXT_GLYPH_ACTION_TAB)
+        {
+            if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+            {
+                break;
+            }
+            __private_vtxt_emit_glyph(__private_vtxt_scaled_glyph(slot, font, text_height_px),
+                                      (float) (_vtxt_cursor_x + glyphs_since_cursor * advance),
+                                      (float) _vtxt_cursor_y,
+                                      font->atlas_page);
+            ++glyphs_since_cursor;
+        }
+    }
+    _vtxt_cursor_x += glyphs_since_cursor * advance;
+}
+
+VTXT_DEF void
+vtxt_append_line(const char* line_of_text, vtxt_font* font, int text_height_px)
+{
+    __private_vtxt_damage_begin();
+    if(font->monospace_advance > 0.f)
+    {
+        __private_vtxt_append_line_monospace(line_of_text, font, text_height_px);
+        __private_vtxt_damage_end();
+        return;
+    }
+
+    int line_start_x = _vtxt_cursor_x;
+    while(*line_of_text != '\0')
+    {
+        if(*line_of_text == '\t')
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+        }
+        else if(*line_of_text != '\n')
+        {
+            if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+            {
+                break;
+            }
+            vtxt_append_glyph(*line_of_text, font, text_height_px);
+        }
+        else
+        {
+            vtxt_new_line(line_start_x, font, text_height_px);
+        }
+        ++line_of_text;// next character
+    }
+    __private_vtxt_damage_end();
+}
+
+/** Returns the index of the first '\n' in text[from, end), or end. */
+_vtxt_internal size_t
+__private_vtxt_find_newline(const char* text, size_t from, size_t end)
+{
+    size_t i = from;
+#ifdef VTXT_SSE2
+    const __m128i newline = _mm_set1_epi8('\n');
+    for(; i + 16 <= end; i += 16)
+    {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (text + i)), newline));
+        if(mask != 0)
+        {
+            while(!(mask & 1))
+            {
+                mask >>= 1;
+                ++i;
+            }
+            return i;
+        }
+    }
+#endif
+    for(; i < end; ++i)
+    {
+        if(text[i] == '\n')
+        {
+            return i;
+        }
+    }
+    return end;
+}
+
+/** State shared by the tasks of one vtxt_append_line_parallel. Chunk i is text[starts[i], starts[i + 1]) and
+    starts at the beginning of a line. */
+typedef struct _vtxt_line_chunk_job
+{
+    const char*     text;
+    vtxt_font*      font;
+    int             text_height_px;
+    int             line_start_x;
+    int             line_start_y;
+    int             line_step;          // what vtxt_new_line adds to the cursor y
+    size_t*         starts;
+    int*            glyph_counts;       // per chunk, set by the counting pass
+    int*            line_counts;        // per chunk, count of '\n'
+    int*            first_quads;        // per chunk, prefix sums of glyph_counts
+    int*            first_lines;        // per chunk, prefix sums of line_counts
+    int*            end_x;              // per chunk, cursor x after it relative to line_start_x
+    int             stream;             // VTXT_STREAMING_STORES applies, each task streams through a gather of its own
+    _vtxt_damage_accum* damage;         // per chunk, what VTXT_TRACK_DAMAGE gathered (NULL when it is off)
+} _vtxt_line_chunk_job;
+
+_vtxt_internal void
+__private_vtxt_count_chunk_task(void* task_data, int task_index)
+{
+    _vtxt_line_chunk_job* job = (_vtxt_line_chunk_job*) task_data;
+    const unsigned char* text = (const unsigned char*) job->text;
+    const unsigned char* glyph_map = job->font->glyph_map;
+    int glyph_count = 0;
+    int line_count = 0;
+    for(size_t i = job->starts[task_index]; i < job->starts[task_index + 1]; ++i)
+    {
+        glyph_count += glyph_map[text[i]] < VTXT_GLYPH_ACTION_TAB;
+        line_count += text[i] == '\n';
+    }
+    job->glyph_counts[task_index] = glyph_count;
+    job->line_counts[task_index] = line_count;
+}
+
+_vtxt_internal void
+__private_vtxt_layout_chunk_task(void* task_data, int task_index)
+{
+    // Same steps as vtxt_append_line, with the cursor kept relative to where the chunk's first line starts
+    _vtxt_line_chunk_job* job = (_vtxt_line_chunk_job*) task_data;
+    vtxt_font* font = job->font;
+    int indexed = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) != 0;
+    int vertex = job->first_quads[task_index] * (indexed ? 4 : 6) + _vtxt_vertex_count;
+    int index = job->first_quads[task_index] * (indexed ? 6 : 0) + _vtxt_index_count;
+    int line = job->first_lines[task_index];
+    int x = 0;
+    // Only the cache lines a chunk shares with its neighbours are streamed out partially
+    _vtxt_stream_gather gather;
+    memset(&gather, 0, sizeof(gather));
+    _vtxt_stream_gather* stream = job->stream ? &gather : NULL;
+    _vtxt_damage_accum* damage = job->damage ? &job->damage[task_index] : NULL;
+    if(damage)
+    {
+        __private_vtxt_damage_reset(damage);
+    }
+    // Monospace fonts advance by the shared advance, like __private_vtxt_append_line_monospace
+    int monospace_advance = (int) (font->monospace_advance * ((float) job->text_height_px / (float) font->font_height_px));
+    for(size_t i = job->starts[task_index]; i < job->starts[task_index + 1]; ++i)
+    {
+        int slot = font->glyph_map[(unsigned char) job->text[i]];
+        if(slot < VTXT_GLYPH_ACTION_TAB)
+        {
+            vtxt_glyph glyph = __private_vtxt_scaled_glyph(slot, font, job->text_height_px);
+            __private_vtxt_emit_glyph_at(glyph, (float) (job->line_start_x + x), (float) (job->line_start_y + line * job->line_step),
+                                         font->atlas_page, vertex, index, stream, damage);
+            x += monospace_advance > 0 ? monospace_advance : (int) glyph.advance;
+            vertex += indexed ? 4 : 6;
+            index += indexed ? 6 : 0;
+        }
+        else if(slot == VTXT_GLYPH_ACTION_TAB)
+        {
+            x = __private_vtxt_next_tab_stop(x, font, job->text_height_px);
+        }
+        else if(slot == VTXT_GLYPH_ACTION_NEWLINE)
+        {
+            x = 0;
+            ++line;
+        }
+    }
+    job->end_x[task_index] = x;
+    __private_vtxt_flush_gather(&gather); // fenced before the task is done, so the caller sees every store
+}
+
+VTXT_DEF void
+vtxt_append_line_parallel(const char* text, vtxt_font* font, int text_height_px,
+                          vtxt_parallel_for_fn parallel_for, void* user_data)
+{
+    size_t length = strlen(text);
+    int chunk_count = (int) (length / VTXT_LINE_CHUNK_BYTES);
+    if(parallel_for == NULL || chunk_count < 2)
+    {
+        vtxt_append_line(text, font, text_height_px);
+        return;
+    }
+
+    // Chunks start right after a '\n', so every chunk starts a line at line_start_x
+    _vtxt_line_chunk_job job;
+    job.starts = (size_t*) malloc(sizeof(size_t) * (size_t) (chunk_count + 1));
+    job.starts[0] = 0;
+    for(int chunk = 1; chunk < chunk_count; ++chunk)
+    {
+        size_t split = length / (size_t) chunk_count * (size_t) chunk;
+        split = split > job.starts[chunk - 1] ? split : job.starts[chunk - 1];
+        size_t newline = __private_vtxt_find_newline(text, split, length);
+        job.starts[chunk] = newline < length ? newline + 1 : length;
+    }
+    job.starts[chunk_count] = length;
+    job.text = text;
+    job.font = font;
+    job.text_height_px = text_height_px;
+    job.glyph_counts = (int*) malloc(sizeof(int) * 5 * (size_t) chunk_count);
+    job.line_counts = job.glyph_counts + chunk_count;
+    job.first_quads = job.line_counts + chunk_count;
+    job.first_lines = job.first_quads + chunk_count;
+    job.end_x = job.first_lines + chunk_count;
+    parallel_for(__private_vtxt_count_chunk_task, &job, chunk_count, user_data);
+
+    int quad_count = 0;
+    int line_count = 0;
+    for(int chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        job.first_quads[chunk] = quad_count;
+        job.first_lines[chunk] = line_count;
+        quad_count += job.glyph_counts[chunk];
+        line_count += job.line_counts[chunk];
+    }
+
+    // If it doesn't all fit, vtxt_append_line stops at the first glyph that doesn't, cursor and all
+    int indexed = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) != 0;
+    if(!__private_vtxt_has_room((quad_count + 1) * (indexed ? 4 : 6), (quad_count + 1) * (indexed ? 6 : 0)))
+    {
+        free(job.starts);
+        free(job.glyph_counts);
+        vtxt_append_line(text, font, text_height_px);
+        return;
+    }
+
+    __private_vtxt_damage_begin();
+    int y = _vtxt_cursor_y;
+    vtxt_new_line(_vtxt_cursor_x, font, text_height_px); // tells how far a line moves the cursor with the current flags
+    job.line_start_x = _vtxt_cursor_x;
+    job.line_start_y = y;
+    job.line_step = _vtxt_cursor_y - y;
+    job.stream = __private_vtxt_streaming() != NULL;
+    job.damage = __private_vtxt_damage_accum() ? (_vtxt_damage_accum*) malloc(sizeof(_vtxt_damage_accum) * (size_t) chunk_count) : NULL;
+    parallel_for(__private_vtxt_layout_chunk_task, &job, chunk_count, user_data);
+    if(job.damage)
+    {
+        for(int chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            __private_vtxt_damage_merge(&_vtxt_damage, &job.damage[chunk]);
+        }
+        free(job.damage);
+    }
+
+    // The cursor ends where the last chunk with any text left it
+    int last_chunk = chunk_count - 1;
+    while(job.starts[last_chunk] == job.starts[last_chunk + 1])
+    {
+        --last_chunk;
+    }
+    int end_x = job.end_x[last_chunk];
+    _vtxt_cursor_x = job.line_start_x + end_x;
+    _vtxt_cursor_y = y + line_count * job.line_step;
+    _vtxt_vertex_count += quad_count * (indexed ? 4 : 6);
+    _vtxt_index_count += quad_count * (indexed ? 6 : 0);
+    free(job.starts);
+    free(job.glyph_counts);
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF void
+vtxt_append_line_spans(const char* text, int text_length, vtxt_font* font, int text_height_px,
+                       const vtxt_span* spans, int span_count)
+{
+    // Merge-walk the spans alongside the text: the color only changes at span boundaries, so
+    // each character costs a single compare against the next boundary instead of a span lookup.
+    __private_vtxt_damage_begin();
+    unsigned int base_color = _vtxt_color;
+    int line_start_x = _vtxt_cursor_x;
+    int span_index = 0;
+    int next_boundary = 0;
+    for(int i = 0; i < text_length; ++i)
+    {
+        if(i == next_boundary)
+        {
+            while(span_index < span_count && spans[span_index].start + spans[span_index].length <= i)
+            {
+                ++span_index;
+            }
+            if(span_index < span_count && spans[span_index].start <= i)
+            {
+                _vtxt_color = spans[span_index].color;
+                next_boundary = spans[span_index].start + spans[span_index].length;
+            }
+            else
+            {
+                _vtxt_color = base_color;
+                next_boundary = span_index < span_count ? spans[span_index].start : text_length;
+            }
+        }
+
+        if(text[i] == '\t')
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+        }
+        else if(text[i] != '\n')
+        {
+            if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+            {
+                break;
+            }
+            __private_vtxt_append_glyph(text[i], font, text_height_px, 0.f);
+        }
+        else
+        {
+            vtxt_new_line(line_start_x, font, text_height_px);
+        }
+    }
+    _vtxt_color = base_color;
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF void
+vtxt_append_table(const char* text, vtxt_font* font, int text_height_px, int column_gap_px)
+{
+    __private_vtxt_damage_begin();
+
+    // Pass 1: measure each cell once and keep the widest cell of every column
+    int column_widths[VTXT_MAX_TABLE_COLUMNS] = {0};
+    int column = 0;
+    int cell_width = 0;
+    for(const char* c = text; ; ++c)
+    {
+        if(*c == '\t' || *c == '\n' || *c == '\0')
+        {
+            if(column < VTXT_MAX_TABLE_COLUMNS && cell_width > column_widths[column])
+            {
+                column_widths[column] = cell_width;
+            }
+            cell_width = 0;
+            column = *c == '\t' ? column + 1 : 0;
+            if(*c == '\0')
+            {
+                break;
+            }
+        }
+        else
+        {
+            cell_width += __private_vtxt_glyph_advance(*c, font, text_height_px);
+        }
+    }
+
+    int column_x[VTXT_MAX_TABLE_COLUMNS];
+    int table_x = _vtxt_cursor_x;
+    int x = table_x;
+    for(int i = 0; i < VTXT_MAX_TABLE_COLUMNS; ++i)
+    {
+        column_x[i] = x;
+        x += column_widths[i] + column_gap_px;
+    }
+
+    // Pass 2: emit every cell at its column's x
+    column = 0;
+    for(const char* c = text; *c != '\0'; ++c)
+    {
+        if(*c == '\t')
+        {
+            ++column;
+            _vtxt_cursor_x = column < VTXT_MAX_TABLE_COLUMNS ? column_x[column] : _vtxt_cursor_x + column_gap_px;
+        }
+        else if(*c == '\n')
+        {
+            column = 0;
+            vtxt_new_line(table_x, font, text_height_px);
+        }
+        else
+        {
+            if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+            {
+                break;
+            }
+            __private_vtxt_append_glyph(*c, font, text_height_px, 0.f);
+        }
+    }
+    __private_vtxt_damage_end();
+}
+
+/** Height of one line in pixels, i.e. how far vtxt_new_line moves the cursor. */
+_vtxt_internal int
+__private_vtxt_line_height(vtxt_font* font, int text_height_px)
+{
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    return (int) ((-font->descender + font->linegap + _vtxt_linegap_offset + font->ascender) * scale);
+}
+
+/** A word that was hyphenated recently: its letters (lowercase) and where hyphens can go. */
+typedef struct _vtxt_hyphen_memo
+{
+    unsigned long long  breaks;     // bit i set if a hyphen can go before letter byte i
+    int                 length;     // 0 for an empty slot
+    unsigned char       word[VTXT_MAX_HYPHEN_WORD];
+} _vtxt_hyphen_memo;
+
+/** Letters are what hyphenation patterns are made of: ASCII letters and any byte of a UTF-8 sequence. */
+_vtxt_internal int
+__private_vtxt_is_word_letter(char c)
+{
+    unsigned char byte = (unsigned char) c;
+    return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || byte >= 0x80;
+}
+
+_vtxt_internal unsigned char
+__private_vtxt_to_lower(unsigned char c)
+{
+    return c >= 'A' && c <= 'Z' ? (unsigned char) (c - 'A' + 'a') : c;
+}
+
+VTXT_DEF int
+vtxt_init_hyphenator(vtxt_hyphenator* hyphenator, const char* patterns)
+{
+    memset(hyphenator, 0, sizeof(*hyphenator));
+    hyphenator->patterns_hash = __private_vtxt_hash(patterns, strlen(patterns), 0xCBF29CE484222325ULL);
+
+    // Build a linked trie first (first child, next sibling), then lay it out breadth first
+    int capacity = 256;
+    int node_count = 1;
+    int* first = (int*) malloc(sizeof(int) * (size_t) capacity);
+    int* sibling = (int*) malloc(sizeof(int) * (size_t) capacity);
+    unsigned char* label = (unsigned char*) malloc((size_t) capacity);
+    int* value = (int*) malloc(sizeof(int) * (size_t) capacity);
+    first[0] = -1;
+    sibling[0] = -1;
+    label[0] = 0;
+    value[0] = -1;
+    size_t digits_capacity = 256;
+    size_t digit_count = 0;
+    unsigned char* digits = (unsigned char*) malloc(digits_capacity);
+    int pattern_count = 0;
+
+    const char* c = patterns;
+    for(;;)
+    {
+        while(*c == ' ' || *c == '\t' || *c == '\n' || *c == '\r')
+        {
+            ++c;
+        }
+        if(*c == '\0')
+        {
+            break;
+        }
+        // Patterns longer than a word with its two '.' never match, so they are skipped
+        unsigned char pattern_digits[VTXT_MAX_HYPHEN_WORD + 3];
+        int letter_count = 0;
+        int node = 0;
+        pattern_digits[0] = 0;
+        for(; *c != '\0' && *c != ' ' && *c != '\t' && *c != '\n' && *c != '\r'; ++c)
+        {
+            if(*c >= '0' && *c <= '9')
+            {
+                pattern_digits[letter_count < VTXT_MAX_HYPHEN_WORD + 2 ? letter_count : VTXT_MAX_HYPHEN_WORD + 2] = (unsigned char) (*c - '0');
+                continue;
+            }
+            if(letter_count == VTXT_MAX_HYPHEN_WORD + 2)
+            {
+                node = -1;
+                continue;
+            }
+            unsigned char letter = __private_vtxt_to_lower((unsigned char) *c);
+            int child = first[node];
+            while(child >= 0 && label[child] != letter)
+            {
+                child = sibling[child];
+            }
+            if(child < 0)
+            {
+                if(node_count == capacity)
+                {
+                    capacity *= 2;
+                    first = (int*) realloc(first, sizeof(int) * (size_t) capacity);
+                    sibling = (int*) realloc(sibling, sizeof(int) * (size_t) capacity);
+                    label = (unsigned char*) realloc(label, (size_t) capacity);
+                    value = (int*) realloc(value, sizeof(int) * (size_t) capacity);
+                }
+                child = node_count++;
+                first[child] = -1;
+                sibling[child] = first[node];
+                label[child] = letter;
+                value[child] = -1;
+                first[node] = child;
+            }
+            node = child;
+            pattern_digits[++letter_count] = 0;
+        }
+        if(node <= 0)
+        {
+            continue;
+        }
+        if(digit_count + (size_t) letter_count + 1 > digits_capacity)
+        {
+            digits_capacity = digits_capacity * 2 + (size_t) letter_count + 1;
+            digits = (unsigned char*) realloc(digits, digits_capacity);
+        }
+        value[node] = (int) digit_count;
+        memcpy(digits + digit_count, pattern_digits, (size_t) letter_count + 1);
+        digit_count += (size_t) letter_count + 1;
+        ++pattern_count;
+    }
+
+    // Children are queued together, so every node's children end up contiguous right after the previous node's
+    int* order = (int*) malloc(sizeof(int) * (size_t) node_count);
+    hyphenator->node_count = node_count;
+    hyphenator->labels = (unsigned char*) malloc((size_t) node_count);
+    hyphenator->first_child = (int*) malloc(sizeof(int) * (size_t) (node_count + 1));
+    hyphenator->values = (int*) malloc(sizeof(int) * (size_t) node_count);
+    order[0] = 0;
+    int queued = 1;
+    for(int node = 0; node < node_count; ++node)
+    {
+        int old_node = order[node];
+        hyphenator->labels[node] = label[old_node];
+        hyphenator->values[node] = value[old_node];
+        hyphenator->first_child[node] = queued;
+        for(int child = first[old_node]; child >= 0; child = sibling[child])
+        {
+            order[queued++] = child;
+        }
+    }
+    hyphenator->first_child[node_count] = queued;
+    hyphenator->digits = digits;
+    hyphenator->left_min = 2;
+    hyphenator->right_min = 2;
+    hyphenator->memo = (_vtxt_hyphen_memo*) calloc(VTXT_HYPHEN_MEMO_SLOTS, sizeof(_vtxt_hyphen_memo));
+    free(order);
+    free(first);
+    free(sibling);
+    free(label);
+    free(value);
+    return pattern_count;
+}
+
+VTXT_DEF void
+vtxt_free_hyphenator(vtxt_hyphenator* hyphenator)
+{
+    if(_vtxt_hyphenator == hyphenator)
+    {
+        _vtxt_hyphenator = NULL;
+    }
+    free(hyphenator->labels);
+    free(hyphenator->first_child);
+    free(hyphenator->values);
+    free(hyphenator->digits);
+    free(hyphenator->memo);
+    memset(hyphenator, 0, sizeof(*hyphenator));
+}
+
+VTXT_DEF void
+vtxt_set_hyphenator(vtxt_hyphenator* hyphenator)
+{
+    _vtxt_hyphenator = hyphenator;
+}
+
+/** Returns where a hyphen can go in word (1 to VTXT_MAX_HYPHEN_WORD letter bytes): bit i is set if it can go
+    before word[i]. Words are looked up in the memo first, so text that is wrapped again every frame only runs
+    the patterns once per word. */
+_vtxt_internal unsigned long long
+__private_vtxt_hyphen_breaks(vtxt_hyphenator* hyphenator, const char* word, int length)
+{
+    // The patterns match against the lowercase word with a '.' at each end
+    unsigned char dotted[VTXT_MAX_HYPHEN_WORD + 2];
+    dotted[0] = '.';
+    for(int i = 0; i < length; ++i)
+    {
+        dotted[i + 1] = __private_vtxt_to_lower((unsigned char) word[i]);
+    }
+    dotted[length + 1] = '.';
+
+    unsigned long long hash = __private_vtxt_hash(dotted + 1, (size_t) length, 0xCBF29CE484222325ULL);
+    _vtxt_hyphen_memo* memo = &hyphenator->memo[hash & (VTXT_HYPHEN_MEMO_SLOTS - 1)];
+    if(memo->length == length && memcmp(memo->word, dotted + 1, (size_t) length) == 0)
+    {
+        return memo->breaks;
+    }
+
+    // Every pattern that matches somewhere raises the points between its letters to its digits
+    unsigned char points[VTXT_MAX_HYPHEN_WORD + 3];
+    memset(points, 0, sizeof(points));
+    for(int start = 0; start < length + 2; ++start)
+    {
+        int node = 0;
+        for(int i = start; i < length + 2; ++i)
+        {
+            int child = hyphenator->first_child[node];
+            int children_end = hyphenator->first_child[node + 1];
+            while(child < children_end && hyphenator->labels[child] != dotted[i])
+            {
+                ++child;
+            }
+            if(child == children_end)
+            {
+                break;
+            }
+            node = child;
+            if(hyphenator->values[node] >= 0)
+            {
+                const unsigned char* pattern_digits = hyphenator->digits + hyphenator->values[node];
+                for(int k = 0; k <= i - start + 1; ++k)
+                {
+                    points[start + k] = pattern_digits[k] > points[start + k] ? pattern_digits[k] : points[start + k];
+                }
+            }
+        }
+    }
+
+    // Odd points are hyphens, except too close to either end (counted in characters, not UTF-8 bytes)
+    int char_count = 0;
+    for(int i = 0; i < length; ++i)
+    {
+        char_count += ((unsigned char) word[i] & 0xC0) != 0x80;
+    }
+    unsigned long long breaks = 0;
+    int chars_before = 1;
+    for(int i = 1; i < length; ++i)
+    {
+        if(((unsigned char) word[i] & 0xC0) == 0x80)
+        {
+            continue;
+        }
+        if((points[i + 1] & 1) && chars_before >= hyphenator->left_min && char_count - chars_before >= hyphenator->right_min)
+        {
+            breaks |= 1ULL << i;
+        }
+        ++chars_before;
+    }
+
+    memo->breaks = breaks;
+    memo->length = length;
+    memcpy(memo->word, dotted + 1, (size_t) length);
+    return breaks;
+}
+
+VTXT_DEF int
+vtxt_hyphenate(vtxt_hyphenator* hyphenator, const char* word, int word_length, int* offsets_out, int max_offsets)
+{
+    if(word_length < 2 || word_length > VTXT_MAX_HYPHEN_WORD)
+    {
+        return 0;
+    }
+    unsigned long long breaks = __private_vtxt_hyphen_breaks(hyphenator, word, word_length);
+    int offset_count = 0;
+    for(int i = 1; i < word_length; ++i)
+    {
+        if((breaks >> i) & 1)
+        {
+            if(offset_count < max_offsets)
+            {
+                offsets_out[offset_count] = i;
+            }
+            ++offset_count;
+        }
+    }
+    return offset_count;
+}
+
+/** For the word at text[word_start] that overflows the line starting at text[line_start]: returns the last
+    point where it can be hyphenated with the line and the '-' still fitting in max_width_px, or -1. */
+_vtxt_internal int
+__private_vtxt_hyphen_break(const char* text, int line_start, int word_start, vtxt_font* font, int text_height_px, int max_width_px)
+{
+    // Hyphenate the letters of the word, not the quotes or punctuation around them
+    int letters_start = word_start;
+    while(text[letters_start] != '\0' && text[letters_start] != ' ' && text[letters_start] != '\n'
+          && !__private_vtxt_is_word_letter(text[letters_start]))
+    {
+        ++letters_start;
+    }
+    int letters_end = letters_start;
+    while(__private_vtxt_is_word_letter(text[letters_end]))
+    {
+        ++letters_end;
+    }
+    int length = letters_end - letters_start;
+    if(length < 2 || length > VTXT_MAX_HYPHEN_WORD)
+    {
+        return -1;
+    }
+    unsigned long long breaks = __private_vtxt_hyphen_breaks(_vtxt_hyphenator, text + letters_start, length);
+    if(breaks == 0)
+    {
+        return -1;
+    }
+
+    int width = 0;
+    for(int i = line_start; i < letters_start; ++i)
+    {
+        width += __private_vtxt_advance_at(text[i], width, font, text_height_px);
+    }
+    int hyphen_width = __private_vtxt_glyph_advance('-', font, text_height_px);
+    int best = -1;
+    for(int i = letters_start; i < letters_end - 1; ++i)
+    {
+        width += __private_vtxt_glyph_advance(text[i], font, text_height_px);
+        if(width + hyphen_width > max_width_px)
+        {
+            break;
+        }
+        if((breaks >> (i + 1 - letters_start)) & 1)
+        {
+            best = i + 1;
+        }
+    }
+    return best;
+}
+
+/** Word wraps the line that starts at text[start] to max_width_px. Returns the end (exclusive) of the
+    characters to draw on the line and sets *next_start to where the next line starts, after the spaces,
+    tabs or '\n' the line was broken at. Lines break after the last space or tab that fits, or inside a
+    word that is wider than the whole line. Tabs are measured to the next tab stop from the line start.
+    A line always takes at least one character, so wrapping always advances. With a hyphenator set, the
+    word that overflows is hyphenated first if part of it fits; then the line ends inside the word and
+    *hyphen is set to say a '-' is drawn after it.
+*/
+_vtxt_internal int
+__private_vtxt_wrap_line(const char* text, int start, vtxt_font* font, int text_height_px, int max_width_px, int* next_start,
+                         int* hyphen)
+{
+    int width = 0;
+    int last_space = -1;
+    int i = start;
+    *hyphen = 0;
+    for(; text[i] != '\0'; ++i)
+    {
+        char c = text[i];
+        if(c == '\n')
+        {
+            *next_start = i + 1;
+            return i;
+        }
+        int advance = __private_vtxt_advance_at(c, width, font, text_height_px);
+        if(c == ' ' || c == '\t')
+        {
+            last_space = i;
+        }
+        else if(width + advance > max_width_px && i > start)
+        {
+            if(_vtxt_hyphenator != NULL)
+            {
+                int word_start = last_space >= 0 ? last_space + 1 : start;
+                int hyphen_at = __private_vtxt_hyphen_break(text, start, word_start, font, text_height_px, max_width_px);
+                if(hyphen_at > start)
+                {
+                    *next_start = hyphen_at;
+                    *hyphen = 1;
+                    return hyphen_at;
+                }
+            }
+            int line_end = last_space >= 0 ? last_space : i;
+            int next = line_end;
+            while(text[next] == ' ' || text[next] == '\t')
+            {
+                ++next;
+            }
+            *next_start = next;
+            return line_end;
+        }
+        width += advance;
+    }
+    *next_start = i;
+    return i;
+}
+
+/** Draws text[line_start, line_end) from the cursor, followed by a '-' if hyphen is set. Tab stops are
+    relative to the cursor at the start of the line, like __private_vtxt_wrap_line measured them. */
+_vtxt_internal void
+__private_vtxt_append_wrapped_line(const char* text, int line_start, int line_end, int hyphen, vtxt_font* font, int text_height_px)
+{
+    int line_start_x = _vtxt_cursor_x;
+    for(int i = line_start; i < line_end; ++i)
+    {
+        if(font->glyph_map[(unsigned char) text[i]] == VTXT_GLYPH_ACTION_TAB)
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+            continue;
+        }
+        if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+        {
+            return;
+        }
+        __private_vtxt_append_glyph(text[i], font, text_height_px, 0.f);
+    }
+    if(hyphen && __private_vtxt_has_room_for_quad())
+    {
+        __private_vtxt_append_glyph('-', font, text_height_px, 0.f);
+    }
+}
+
+VTXT_DEF void
+vtxt_append_paragraph(const char* text, vtxt_font* font, int text_height_px, int box_width_px)
+{
+    __private_vtxt_damage_begin();
+    int line_start_x = _vtxt_cursor_x;
+    int line_start = 0;
+    while(text[line_start] != '\0')
+    {
+        if(line_start > 0)
+        {
+            vtxt_new_line(line_start_x, font, text_height_px);
+        }
+        int next_start;
+        int hyphen;
+        int line_end = __private_vtxt_wrap_line(text, line_start, font, text_height_px, box_width_px, &next_start, &hyphen);
+        __private_vtxt_append_wrapped_line(text, line_start, line_end, hyphen, font, text_height_px);
+        line_start = next_start;
+    }
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF int
+vtxt_paginate(const char* text, vtxt_font* font, int text_height_px, int box_width_px, int box_height_px,
+              int* page_offsets, int max_pages)
+{
+    // One pass over the text with the same line breaking as vtxt_append_page: every
+    // lines_per_page lines the offset of the next line starts a new page.
+    int line_height = __private_vtxt_line_height(font, text_height_px);
+    int lines_per_page = line_height > 0 ? box_height_px / line_height : 1;
+    lines_per_page = lines_per_page > 0 ? lines_per_page : 1;
+    int page_count = 0;
+    int line_start = 0;
+    int lines_on_page = 0;
+    while(text[line_start] != '\0')
+    {
+        if(lines_on_page == 0)
+        {
+            if(page_count == max_pages)
+            {
+                break;
+            }
+            page_offsets[page_count++] = line_start;
+        }
+        int next_start;
+        int hyphen;
+        __private_vtxt_wrap_line(text, line_start, font, text_height_px, box_width_px, &next_start, &hyphen);
+        line_start = next_start;
+        lines_on_page = lines_on_page + 1 < lines_per_page ? lines_on_page + 1 : 0;
+    }
+    page_offsets[page_count] = line_start;
+    return page_count;
+}
+
+VTXT_DEF void
+vtxt_append_page(const char* text, const int* page_offsets, int page, vtxt_font* font, int text_height_px, int box_width_px)
+{
+    __private_vtxt_damage_begin();
+    int line_start_x = _vtxt_cursor_x;
+    int line_start = page_offsets[page];
+    int page_end = page_offsets[page + 1];
+    while(line_start < page_end)
+    {
+        if(line_start > page_offsets[page])
+        {
+            vtxt_new_line(line_start_x, font, text_height_px);
+        }
+        int next_start;
+        int hyphen;
+        int line_end = __private_vtxt_wrap_line(text, line_start, font, text_height_px, box_width_px, &next_start, &hyphen);
+        __private_vtxt_append_wrapped_line(text, line_start, line_end, hyphen, font, text_height_px);
+        line_start = next_start;
+    }
+    __private_vtxt_damage_end();
+}
+
+/** Returns where the first occurrence of pattern at or after text[from] starts, or -1. */
+_vtxt_internal int
+__private_vtxt_find(const char* text, int from, int text_length, const char* pattern, int pattern_length)
+{
+    int i = from;
+#ifdef VTXT_SSE2
+    // Candidates are positions where both the first and the last byte of the pattern match
+    int last = pattern_length - 1;
+    const __m128i first_byte = _mm_set1_epi8(pattern[0]);
+    const __m128i last_byte = _mm_set1_epi8(pattern[last]);
+    for(; i + last + 16 <= text_length; i += 16)
+    {
+        __m128i first_equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (text + i)), first_byte);
+        __m128i last_equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (text + i + last)), last_byte);
+        int mask = _mm_movemask_epi8(_mm_and_si128(first_equal, last_equal));
+        for(int bit = 0; mask != 0; ++bit, mask >>= 1)
+        {
+            if((mask & 1) && memcmp(text + i + bit, pattern, (size_t) pattern_length) == 0)
+            {
+                return i + bit;
+            }
+        }
+    }
+#endif
+    while(i + pattern_length <= text_length)
+    {
+        const char* candidate = (const char*) memchr(text + i, pattern[0], (size_t) (text_length - pattern_length - i + 1));
+        if(candidate == NULL)
+        {
+            return -1;
+        }
+        i = (int) (candidate - text);
+        if(memcmp(candidate, pattern, (size_t) pattern_length) == 0)
+        {
+            return i;
+        }
+        ++i;
+    }
+    return -1;
+}
+
+VTXT_DEF int
+vtxt_find_all(const char* text, int text_length, const char* pattern, int pattern_length, unsigned int color,
+              vtxt_span* matches_out, int max_matches)
+{
+    int match_count = 0;
+    if(pattern_length <= 0)
+    {
+        return 0;
+    }
+    int match = __private_vtxt_find(text, 0, text_length, pattern, pattern_length);
+    while(match >= 0)
+    {
+        if(match_count < max_matches)
+        {
+            matches_out[match_count].start = match;
+            matches_out[match_count].length = pattern_length;
+            matches_out[match_count].color = color;
+        }
+        ++match_count;
+        match = __private_vtxt_find(text, match + pattern_length, text_length, pattern, pattern_length);
+    }
+    return match_count;
+}
+
+/** Draws a solid quad in color from x0 to x1 (cursor x values) over the height of the cursor's line. */
+_vtxt_internal void
+__private_vtxt_emit_highlight(int x0, int x1, unsigned int color, vtxt_font* font, int text_height_px)
+{
+    if(x1 <= x0 || !__private_vtxt_has_room_for_quad())
+    {
+        return;
+    }
+    float scale = (float)text_height_px / (float)font->font_height_px;
+    vtxt_glyph rect;
+    memset(&rect, 0, sizeof(rect));
+    rect.width = (float) (x1 - x0);
+    rect.height = (float) __private_vtxt_line_height(font, text_height_px);
+    rect.offset_y = -font->ascender * scale;
+    rect.min_u = font->solid_u;
+    rect.max_u = font->solid_u;
+    rect.min_v = font->solid_v;
+    rect.max_v = font->solid_v;
+    _vtxt_color = color;
+    __private_vtxt_emit_glyph(rect, (float) x0, (float) _vtxt_cursor_y, font->atlas_page);
+}
+
+VTXT_DEF void
+vtxt_append_highlights(const char* text, int visible_start, int visible_end, const vtxt_span* spans, int span_count,
+                       vtxt_font* font, int text_height_px)
+{
+    // First span that ends after visible_start
+    int low = 0;
+    int high = span_count;
+    while(low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if(spans[middle].start + spans[middle].length <= visible_start)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    int span_index = low;
+    if(span_index == span_count || spans[span_index].start >= visible_end)
+    {
+        return;
+    }
+
+    // Move the cursor over the text like vtxt_append_line would, emitting a quad whenever a highlight ends
+    // (or its line does)
+    __private_vtxt_damage_begin();
+    unsigned int base_color = _vtxt_color;
+    int saved_cursor_x = _vtxt_cursor_x;
+    int saved_cursor_y = _vtxt_cursor_y;
+    int line_start_x = _vtxt_cursor_x;
+    int highlight_span = -1;    // span highlighted from highlight_x, -1 if none
+    int highlight_x = 0;
+    for(int i = visible_start; i < visible_end && span_index < span_count; ++i)
+    {
+        while(span_index < span_count && spans[span_index].start + spans[span_index].length <= i)
+        {
+            ++span_index;
+        }
+        int covering_span = span_index < span_count && spans[span_index].start <= i ? span_index : -1;
+        if(covering_span != highlight_span)
+        {
+            if(highlight_span >= 0)
+            {
+                __private_vtxt_emit_highlight(highlight_x, _vtxt_cursor_x, spans[highlight_span].color, font, text_height_px);
+            }
+            highlight_span = covering_span;
+            highlight_x = _vtxt_cursor_x;
+        }
+
+        if(text[i] == '\n')
+        {
+            if(highlight_span >= 0)
+            {
+                __private_vtxt_emit_highlight(highlight_x, _vtxt_cursor_x, spans[highlight_span].color, font, text_height_px);
+            }
+            vtxt_new_line(line_start_x, font, text_height_px);
+            highlight_x = _vtxt_cursor_x;
+        }
+        else if(text[i] == '\t')
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+        }
+        else
+        {
+            _vtxt_cursor_x += __private_vtxt_glyph_advance(text[i], font, text_height_px);
+        }
+    }
+    if(highlight_span >= 0)
+    {
+        __private_vtxt_emit_highlight(highlight_x, _vtxt_cursor_x, spans[highlight_span].color, font, text_height_px);
+    }
+    _vtxt_color = base_color;
+    _vtxt_cursor_x = saved_cursor_x;
+    _vtxt_cursor_y = saved_cursor_y;
+    __private_vtxt_damage_end();
+}
+
+/** Identifies the glyph metrics and the hyphenator (the patterns and their limits) a string table was
+    measured with, so a table compiled for another font, another build of it, or another language's
+    hyphenation can be told apart at load time. */
+_vtxt_internal unsigned long long
+__private_vtxt_font_metrics_key(const vtxt_font* font)
+{
+    float line_metrics[] = { (float) font->font_height_px, font->ascender, font->descender, font->linegap + _vtxt_linegap_offset };
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    hash = __private_vtxt_hash(line_metrics, sizeof(line_metrics), hash);
+    hash = __private_vtxt_hash(font->glyphs, sizeof(font->glyphs), hash);
+    if(_vtxt_hyphenator != NULL)
+    {
+        unsigned long long hyphenation[] = { _vtxt_hyphenator->patterns_hash, (unsigned long long) _vtxt_hyphenator->left_min,
+                                             (unsigned long long) _vtxt_hyphenator->right_min };
+        hash = __private_vtxt_hash(hyphenation, sizeof(hyphenation), hash);
+    }
+    return hash;
+}
+
+VTXT_DEF void
+vtxt_compile_string_table(vtxt_string_table* table, const char* const* strings, int string_count,
+                          vtxt_font* font, int text_height_px, int box_width_px)
+{
+    memset(table, 0, sizeof(*table));
+    box_width_px = box_width_px > 0 ? box_width_px : 0x7FFFFFFF;
+    size_t text_size = 0;
+    int line_capacity = 0;
+    for(int id = 0; id < string_count; ++id)
+    {
+        size_t length = strlen(strings[id]);
+        text_size += length + 1;
+        line_capacity += (int) length + 1; // a string never has more lines than characters
+    }
+
+    table->string_count = string_count;
+    table->text_height_px = text_height_px;
+    table->box_width_px = box_width_px;
+    table->font_key = __private_vtxt_font_metrics_key(font);
+    table->text_size = (int) text_size;
+    table->text = (char*) malloc(text_size > 0 ? text_size : 1);
+    table->string_offsets = (int*) malloc(sizeof(int) * (size_t) (string_count > 0 ? string_count : 1));
+    table->metrics = (vtxt_string_metrics*) malloc(sizeof(vtxt_string_metrics) * (size_t) (string_count > 0 ? string_count : 1));
+    table->line_breaks = (int*) malloc(sizeof(int) * 2 * (size_t) (line_capacity > 0 ? line_capacity : 1));
+    table->line_hyphens = (unsigned char*) malloc((size_t) (line_capacity > 0 ? line_capacity : 1));
+    table->tab_stops = (int*) malloc(sizeof(int) * VTXT_MAX_TAB_STOPS);
+    table->tab_stop_count = _vtxt_tab_stop_count;
+    table->tab_interval = _vtxt_tab_interval;
+    memcpy(table->tab_stops, _vtxt_tab_stops, sizeof(int) * (size_t) _vtxt_tab_stop_count);
+
+    float scale = (float) text_height_px / (float) font->font_height_px;
+    float line_height = (font->ascender - font->descender + font->linegap + _vtxt_linegap_offset) * scale;
+    int text_offset = 0;
+    for(int id = 0; id < string_count; ++id)
+    {
+        // Same breaks as vtxt_append_paragraph, measured like vtxt_get_text_bounding_box_info
+        char* text = table->text + text_offset;
+        size_t length = strlen(strings[id]);
+        memcpy(text, strings[id], length + 1);
+        vtxt_string_metrics* metrics = &table->metrics[id];
+        metrics->width = 0.f;
+        metrics->first_line = table->line_count;
+        metrics->line_count = 0;
+        int line_start = 0;
+        while(text[line_start] != '\0')
+        {
+            int next_start;
+            int hyphen;
+            int line_end = __private_vtxt_wrap_line(text, line_start, font, text_height_px, box_width_px, &next_start, &hyphen);
+            int pen_x = 0;
+            float line_width = 0.f;
+            for(int i = line_start; i < line_end + hyphen; ++i)
+            {
+                char c = i < line_end ? text[i] : '-';
+                int slot = font->glyph_map[(unsigned char) c];
+                if(slot < VTXT_GLYPH_ACTION_TAB)
+                {
+                    vtxt_glyph glyph = font->glyphs[slot];
+                    line_width = (float) pen_x + (glyph.offset_x + glyph.width) * scale;
+                }
+                pen_x += __private_vtxt_advance_at(c, pen_x, font, text_height_px);
+            }
+            metrics->width = line_width > metrics->width ? line_width : metrics->width;
+            table->line_breaks[table->line_count * 2 + 0] = text_offset + line_start;
+            table->line_breaks[table->line_count * 2 + 1] = text_offset + line_end;
+            table->line_hyphens[table->line_count] = (unsigned char) hyphen;
+            ++table->line_count;
+            ++metrics->line_count;
+            line_start = next_start;
+        }
+        metrics->height = (float) metrics->line_count * line_height;
+        table->string_offsets[id] = text_offset;
+        text_offset += (int) length + 1;
+    }
+}
+
+VTXT_DEF void
+vtxt_free_string_table(vtxt_string_table* table)
+{
+    free(table->text);
+    free(table->string_offsets);
+    free(table->metrics);
+    free(table->line_breaks);
+    free(table->line_hyphens);
+    free(table->tab_stops);
+    memset(table, 0, sizeof(*table));
+}
+
+VTXT_DEF const vtxt_string_metrics*
+vtxt_string_table_metrics(const vtxt_string_table* table, int id)
+{
+    if(id < 0 || id >= table->string_count)
+    {
+        return NULL;
+    }
+    return &table->metrics[id];
+}
+
+VTXT_DEF const char*
+vtxt_string_table_text(const vtxt_string_table* table, int id)
+{
+    if(id < 0 || id >= table->string_count)
+    {
+        return NULL;
+    }
+    return table->text + table->string_offsets[id];
+}
+
+VTXT_DEF void
+vtxt_append_string_table_entry(const vtxt_string_table* table, int id, vtxt_font* font)
+{
+    if(id < 0 || id >= table->string_count)
+    {
+        return;
+    }
+    __private_vtxt_damage_begin();
+    // Tabs go to the stops the lines were measured with, whatever the current ones are
+    int saved_stops[VTXT_MAX_TAB_STOPS];
+    int saved_stop_count = _vtxt_tab_stop_count;
+    int saved_interval = _vtxt_tab_interval;
+    memcpy(saved_stops, _vtxt_tab_stops, sizeof(saved_stops));
+    vtxt_set_tab_stops(table->tab_stops, table->tab_stop_count, table->tab_interval);
+    int line_start_x = _vtxt_cursor_x;
+    const vtxt_string_metrics* metrics = &table->metrics[id];
+    for(int line = metrics->first_line; line < metrics->first_line + metrics->line_count; ++line)
+    {
+        if(line > metrics->first_line)
+        {
+            vtxt_new_line(line_start_x, font, table->text_height_px);
+        }
+        __private_vtxt_append_wrapped_line(table->text, table->line_breaks[line * 2 + 0], table->line_breaks[line * 2 + 1],
+                                           table->line_hyphens[line], font, table->text_height_px);
+    }
+    vtxt_set_tab_stops(saved_stops, saved_stop_count, saved_interval);
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF int
+vtxt_string_table_overflows(const vtxt_string_table* table, int box_height_px, int* ids_out, int max_ids)
+{
+    int overflow_count = 0;
+    for(int id = 0; id < table->string_count; ++id)
+    {
+        const vtxt_string_metrics* metrics = &table->metrics[id];
+        if(metrics->width > (float) table->box_width_px || metrics->height > (float) box_height_px)
+        {
+            if(overflow_count < max_ids)
+            {
+                ids_out[overflow_count] = id;
+            }
+            ++overflow_count;
+        }
+    }
+    return overflow_count;
+}
+
+typedef struct _vtxt_string_table_header
+{
+    unsigned int        magic;
+    unsigned int        version;
+    unsigned long long  font_key;
+    int                 metrics_struct_size;
+    int                 text_height_px;
+    int                 box_width_px;
+    int                 string_count;
+    int                 line_count;
+    int                 text_size;
+    int                 tab_stop_count;
+    int                 tab_interval;
+} _vtxt_string_table_header;
+
+VTXT_DEF size_t
+vtxt_save_string_table_to_memory(const vtxt_string_table* table, unsigned char* blob, size_t blob_capacity)
+{
+    size_t string_count = (size_t) table->string_count;
+    size_t size = sizeof(_vtxt_string_table_header) + sizeof(int) * (size_t) table->tab_stop_count
+                + sizeof(int) * string_count + sizeof(vtxt_string_metrics) * string_count
+                + (sizeof(int) * 2 + 1) * (size_t) table->line_count + (size_t) table->text_size;
+    if(blob == NULL || blob_capacity < size)
+    {
+        return size;
+    }
+
+    _vtxt_string_table_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = VTXT_STRING_TABLE_MAGIC;
+    header.version = VTXT_STRING_TABLE_VERSION;
+    header.font_key = table->font_key;
+    header.metrics_struct_size = (int) sizeof(vtxt_string_metrics);
+    header.text_height_px = table->text_height_px;
+    header.box_width_px = table->box_width_px;
+    header.string_count = table->string_count;
+    header.line_count = table->line_count;
+    header.text_size = table->text_size;
+    header.tab_stop_count = table->tab_stop_count;
+    header.tab_interval = table->tab_interval;
+    unsigned char* out = blob;
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    memcpy(out, table->tab_stops, sizeof(int) * (size_t) table->tab_stop_count);
+    out += sizeof(int) * (size_t) table->tab_stop_count;
+    memcpy(out, table->string_offsets, sizeof(int) * string_count);
+    out += sizeof(int) * string_count;
+    memcpy(out, table->metrics, sizeof(vtxt_string_metrics) * string_count);
+    out += sizeof(vtxt_string_metrics) * string_count;
+    memcpy(out, table->line_breaks, sizeof(int) * 2 * (size_t) table->line_count);
+    out += sizeof(int) * 2 * (size_t) table->line_count;
+    memcpy(out, table->line_hyphens, (size_t) table->line_count);
+    out += (size_t) table->line_count;
+    memcpy(out, table->text, (size_t) table->text_size);
+    return size;
+}
+
+VTXT_DEF int
+vtxt_load_string_table_from_memory(vtxt_string_table* table, const unsigned char* blob, size_t blob_size, const vtxt_font* font)
+{
+    _vtxt_string_table_header header;
+    if(blob_size < sizeof(header))
+    {
+        return 0;
+    }
+    memcpy(&header, blob, sizeof(header));
+    if(header.magic != VTXT_STRING_TABLE_MAGIC
+       || header.version != VTXT_STRING_TABLE_VERSION
+       || header.font_key != __private_vtxt_font_metrics_key(font)
+       || header.metrics_struct_size != (int) sizeof(vtxt_string_metrics)
+       || header.string_count < 0
+       || header.line_count < 0
+       || header.text_size < 0
+       || header.tab_stop_count < 0
+       || header.tab_stop_count > VTXT_MAX_TAB_STOPS)
+    {
+        return 0;
+    }
+    size_t string_count = (size_t) header.string_count;
+    size_t line_count = (size_t) header.line_count;
+    size_t size = sizeof(header) + sizeof(int) * (size_t) header.tab_stop_count
+                + sizeof(int) * string_count + sizeof(vtxt_string_metrics) * string_count
+                + (sizeof(int) * 2 + 1) * line_count + (size_t) header.text_size;
+    if(blob_size < size)
+    {
+        return 0;
+    }
+
+    memset(table, 0, sizeof(*table));
+    table->string_count = header.string_count;
+    table->text_height_px = header.text_height_px;
+    table->box_width_px = header.box_width_px;
+    table->font_key = header.font_key;
+    table->line_count = header.line_count;
+    table->text_size = header.text_size;
+    table->string_offsets = (int*) malloc(sizeof(int) * (string_count > 0 ? string_count : 1));
+    table->metrics = (vtxt_string_metrics*) malloc(sizeof(vtxt_string_metrics) * (string_count > 0 ? string_count : 1));
+    table->line_breaks = (int*) malloc(sizeof(int) * 2 * (line_count > 0 ? line_count : 1));
+    table->line_hyphens = (unsigned char*) malloc(line_count > 0 ? line_count : 1);
+    table->text = (char*) malloc(header.text_size > 0 ? (size_t) header.text_size : 1);
+    table->tab_stops = (int*) malloc(sizeof(int) * VTXT_MAX_TAB_STOPS);
+    table->tab_stop_count = header.tab_stop_count;
+    table->tab_interval = header.tab_interval;
+    const unsigned char* in = blob + sizeof(header);
+    memcpy(table->tab_stops, in, sizeof(int) * (size_t) header.tab_stop_count);
+    in += sizeof(int) * (size_t) header.tab_stop_count;
+    memcpy(table->string_offsets, in, sizeof(int) * string_count);
+    in += sizeof(int) * string_count;
+    memcpy(table->metrics, in, sizeof(vtxt_string_metrics) * string_count);
+    in += sizeof(vtxt_string_metrics) * string_count;
+    memcpy(table->line_breaks, in, sizeof(int) * 2 * line_count);
+    in += sizeof(int) * 2 * line_count;
+    memcpy(table->line_hyphens, in, line_count);
+    in += line_count;
+    memcpy(table->text, in, (size_t) header.text_size);
+
+    // Everything indexes text, so a damaged file must not get past here
+    int valid = header.text_size > 0 && table->text[header.text_size - 1] == '\0';
+    for(int id = 0; valid && id < header.string_count; ++id)
+    {
+        const vtxt_string_metrics* metrics = &table->metrics[id];
+        valid = table->string_offsets[id] >= 0 && table->string_offsets[id] < header.text_size
+             && metrics->first_line >= 0 && metrics->line_count >= 0
+             && metrics->line_count <= header.line_count - metrics->first_line;
+    }
+    for(int line = 0; valid && line < header.line_count; ++line)
+    {
+        valid = table->line_breaks[line * 2] >= 0 && table->line_breaks[line * 2] <= table->line_breaks[line * 2 + 1]
+             && table->line_breaks[line * 2 + 1] < header.text_size && table->line_hyphens[line] <= 1;
+    }
+    if(!valid && (header.string_count > 0 || header.text_size > 0))
+    {
+        vtxt_free_string_table(table);
+        return 0;
+    }
+    return 1;
+}
+
+#ifndef VTXT_NO_STDIO
+
+VTXT_DEF int
+vtxt_save_string_table(const vtxt_string_table* table, const char* file_path)
+{
+    size_t size = vtxt_save_string_table_to_memory(table, NULL, 0);
+    unsigned char* blob = (unsigned char*) malloc(size);
+    if(blob == NULL)
+    {
+        return 0;
+    }
+    vtxt_save_string_table_to_memory(table, blob, size);
+    FILE* file = fopen(file_path, "wb");
+    if(file == NULL)
+    {
+        free(blob);
+        return 0;
+    }
+    int ok = fwrite(blob, 1, size, file) == size;
+    free(blob);
+    return fclose(file) == 0 && ok;
+}
+
+VTXT_DEF int
+vtxt_load_string_table(vtxt_string_table* table, const char* file_path, const vtxt_font* font)
+{
+    FILE* file = fopen(file_path, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* blob = file_size > 0 ? (unsigned char*) malloc((size_t) file_size) : NULL;
+    int ok = blob != NULL && fread(blob, 1, (size_t) file_size, file) == (size_t) file_size;
+    fclose(file);
+
+    ok = ok && vtxt_load_string_table_from_memory(table, blob, (size_t) file_size, font);
+    free(blob);
+    return ok;
+}
+
+#endif // VTXT_NO_STDIO
+
+/** Vertex output state that is swapped out while laying out into a block's own memory. */
+typedef struct _vtxt_saved_output
+{
+    int                 config;
+    unsigned char*      output;
+    int                 capacity;
+    vtxt_vertex_layout  layout;
+    int                 layout_is_default;
+    int                 vertex_count;
+    int                 index_count;
+    int                 cursor_x;
+    int                 cursor_y;
+} _vtxt_saved_output;
+
+/** Redirects layout to vertices (room for capacity vertices) as x y u v Screen Space triangles with the
+    cursor at (cursor_x, cursor_y), saving the current output state to saved. */
+_vtxt_internal void
+__private_vtxt_push_block_output(_vtxt_saved_output* saved, float* vertices, int capacity, int cursor_x, int cursor_y)
+{
+    saved->config = _vtxt_config;
+    saved->output = _vtxt_vertex_output;
+    saved->capacity = _vtxt_vertex_capacity;
+    saved->layout = _vtxt_layout;
+    saved->layout_is_default = _vtxt_layout_is_default;
+    saved->vertex_count = _vtxt_vertex_count;
+    saved->index_count = _vtxt_index_count;
+    saved->cursor_x = _vtxt_cursor_x;
+    saved->cursor_y = _vtxt_cursor_y;
+
+    vtxt_vertex_layout default_layout = { 16, { 0, VTXT_FORMAT_FLOAT32x2 }, { 8, VTXT_FORMAT_FLOAT32x2 }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE }, { 0, VTXT_FORMAT_NONE } };
+    _vtxt_config &= ~(VTXT_USE_CLIPSPACE_COORDS | VTXT_CREATE_INDEX_BUFFER | VTXT_CREATE_COLOR_BUFFER | VTXT_TRACK_DAMAGE | VTXT_STREAMING_STORES);
+    _vtxt_vertex_output = (unsigned char*) vertices;
+    _vtxt_vertex_capacity = capacity;
+    _vtxt_layout = default_layout;
+    _vtxt_layout_is_default = 1;
+    _vtxt_vertex_count = 0;
+    _vtxt_index_count = 0;
+    _vtxt_cursor_x = cursor_x;
+    _vtxt_cursor_y = cursor_y;
+}
+
+_vtxt_internal void
+__private_vtxt_pop_block_output(const _vtxt_saved_output* saved)
+{
+    _vtxt_config = saved->config;
+    _vtxt_vertex_output = saved->output;
+    _vtxt_vertex_capacity = saved->capacity;
+    _vtxt_layout = saved->layout;
+    _vtxt_layout_is_default = saved->layout_is_default;
+    _vtxt_vertex_count = saved->vertex_count;
+    _vtxt_index_count = saved->index_count;
+    _vtxt_cursor_x = saved->cursor_x;
+    _vtxt_cursor_y = saved->cursor_y;
+}
+
+/** Converts quad_count triangle quads (6 vertices each) stored from vertex first_quad * 4 of vertices
+    into indexed quads (4 vertices each) in place, and writes their indices from index first_quad * 6.
+    Same corners and winding as indexed vtxt_append_line.
+*/
+_vtxt_internal void
+__private_vtxt_index_block_quads(float* vertices, unsigned int* indices, int first_quad, int quad_count)
+{
+    static const int triangle_vertex_of_corner[4] = { 0, 2, 1, 3 };
+    float* src = vertices + first_quad * 16;
+    for(int q = 0; q < quad_count; ++q)
+    {
+        float corners[16];
+        for(int c = 0; c < 4; ++c)
+        {
+            memcpy(corners + c * 4, src + (q * 6 + triangle_vertex_of_corner[c]) * 4, sizeof(float) * 4);
+        }
+        int quad = first_quad + q;
+        memcpy(vertices + quad * 16, corners, sizeof(corners));
+        indices[quad * 6 + 0] = quad * 4 + 0;
+        indices[quad * 6 + 1] = quad * 4 + 2;
+        indices[quad * 6 + 2] = quad * 4 + 1;
+        indices[quad * 6 + 3] = quad * 4 + 0;
+        indices[quad * 6 + 4] = quad * 4 + 3;
+        indices[quad * 6 + 5] = quad * 4 + 2;
+    }
+}
+
+VTXT_DEF void
+vtxt_make_text_block(vtxt_text_block* block, const char* text, vtxt_font* font, int text_height_px)
+{
+    // Lay out as x y u v triangles straight into the block's memory, then put all the state back
+    int glyph_count = (int) strlen(text);
+    block->vertices = (float*) malloc(sizeof(float) * 4 * 6 * (glyph_count + 1));
+    block->indices = NULL;
+    block->other_form = NULL;
+    block->page = font->atlas_page;
+    block->indexed = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) != 0;
+    _vtxt_saved_output saved;
+    __private_vtxt_push_block_output(&saved, block->vertices, 6 * glyph_count, 0, 0);
+
+    vtxt_append_line(text, font, text_height_px);
+
+    int quad_count = _vtxt_vertex_count / 6;
+    block->vertex_count = _vtxt_vertex_count;
+    block->index_count = 0;
+    if(block->indexed)
+    {
+        block->indices = (unsigned int*) malloc(sizeof(unsigned int) * 6 * (quad_count + 1));
+        __private_vtxt_index_block_quads(block->vertices, block->indices, 0, quad_count);
+        block->vertex_count = quad_count * 4;
+        block->index_count = quad_count * 6;
+    }
+
+    __private_vtxt_pop_block_output(&saved);
+}
+
+VTXT_DEF void
+vtxt_layout_begin(vtxt_layout_state* state, const char* text, vtxt_font* font, int text_height_px, int box_width_px)
+{
+    memset(state, 0, sizeof(*state));
+    state->text = text;
+    state->font = font;
+    state->text_height_px = text_height_px;
+    state->box_width_px = box_width_px > 0 ? box_width_px : 0x7FFFFFFF;
+    state->indexed = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) != 0;
+    state->block.page = font->atlas_page;
+    state->block.indexed = state->indexed;
+    state->line_end = __private_vtxt_wrap_line(text, 0, font, text_height_px, state->box_width_px, &state->next_line_start,
+                                               &state->hyphen);
+    state->done = text[0] == '\0';
+}
+
+/** Lays out up to max_glyphs more characters of state's text as x y u v triangles into vertices (room for
+    6 * max_glyphs vertices), carrying the position and cursor over in state. Returns the number of quads
+    written and the number of characters laid out in glyphs_processed. */
+_vtxt_internal int
+__private_vtxt_layout_glyphs(vtxt_layout_state* state, float* vertices, int max_glyphs, int* glyphs_processed)
+{
+    const char* text = state->text;
+    _vtxt_saved_output saved;
+    __private_vtxt_push_block_output(&saved, vertices, 6 * max_glyphs, state->cursor_x, state->cursor_y);
+    int processed = 0;
+    while(processed < max_glyphs)
+    {
+        if(state->position == state->line_end)
+        {
+            if(state->hyphen)
+            {
+                __private_vtxt_append_glyph('-', state->font, state->text_height_px, 0.f);
+                state->hyphen = 0;
+                ++processed;
+                continue;
+            }
+            if(text[state->next_line_start] == '\0')
+            {
+                state->done = 1;
+                break;
+            }
+            vtxt_new_line(0, state->font, state->text_height_px);
+            state->position = state->next_line_start;
+            state->line_end = __private_vtxt_wrap_line(text, state->position, state->font, state->text_height_px,
+                                                       state->box_width_px, &state->next_line_start, &state->hyphen);
+            continue;
+        }
+        char c = text[state->position++];
+        if(state->font->glyph_map[(unsigned char) c] == VTXT_GLYPH_ACTION_TAB)
+        {
+            __private_vtxt_tab(0, state->font, state->text_height_px); // lines start at x 0 in the block
+        }
+        __private_vtxt_append_glyph(c, state->font, state->text_height_px, 0.f);
+        ++processed;
+    }
+    if(state->position == state->line_end && !state->hyphen && text[state->next_line_start] == '\0')
+    {
+        state->done = 1;
+    }
+    int quad_count = _vtxt_vertex_count / 6;
+    state->cursor_x = _vtxt_cursor_x;
+    state->cursor_y = _vtxt_cursor_y;
+    __private_vtxt_pop_block_output(&saved);
+    *glyphs_processed = processed;
+    return quad_count;
+}
+
+/** Seconds on a monotonic wall clock, for time budgets. clock() counts the CPU time of the whole
+    process instead, which runs fast while other threads are busy and stands still while it waits. */
+_vtxt_internal double
+__private_vtxt_seconds(void)
+{
+#if defined(_WIN32)
+    long long counter; // a LARGE_INTEGER is a 64 bit signed integer
+    long long frequency;
+    QueryPerformanceCounter((union _LARGE_INTEGER*) &counter);
+    QueryPerformanceFrequency((union _LARGE_INTEGER*) &frequency);
+    return (double) counter / (double) frequency;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+#elif defined(__unix__) || defined(__APPLE__)
+    struct timeval now; // wall clock, but not monotonic
+    gettimeofday(&now, NULL);
+    return (double) now.tv_sec + (double) now.tv_usec * 1e-6;
+#else
+    return (double) clock() / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+VTXT_DEF int
+vtxt_layout_continue(vtxt_layout_state* state, int max_glyphs, float max_seconds)
+{
+    if(state->done)
+    {
+        return 1;
+    }
+    double end_time = max_seconds > 0.f ? __private_vtxt_seconds() + (double) max_seconds : 0.0;
+    int glyphs_left = max_glyphs > 0 ? max_glyphs : 0x7FFFFFFF;
+
+    while(!state->done && glyphs_left > 0)
+    {
+        // Lay out in slices so the clock is only read every VTXT_LAYOUT_SLICE glyphs
+        int slice = glyphs_left < VTXT_LAYOUT_SLICE ? glyphs_left : VTXT_LAYOUT_SLICE;
+        int quad_count = state->block.vertex_count / (state->indexed ? 4 : 6);
+        if(quad_count + slice > state->quad_capacity)
+        {
+            int capacity = state->quad_capacity > 0 ? state->quad_capacity * 2 : 256;
+            capacity = capacity >= quad_count + slice ? capacity : quad_count + slice;
+            state->block.vertices = (float*) realloc(state->block.vertices, sizeof(float) * 4 * 6 * (size_t) capacity);
+            if(state->indexed)
+            {
+                state->block.indices = (unsigned int*) realloc(state->block.indices, sizeof(unsigned int) * 6 * (size_t) capacity);
+            }
+            state->quad_capacity = capacity;
+        }
+
+        // New quads go right after the existing ones as triangles, indexed afterwards if needed
+        int processed;
+        int new_quads = __private_vtxt_layout_glyphs(state, state->block.vertices + state->block.vertex_count * 4,
+                                                     slice, &processed);
+        if(state->indexed)
+        {
+            __private_vtxt_index_block_quads(state->block.vertices, state->block.indices, quad_count, new_quads);
+            state->block.vertex_count += new_quads * 4;
+            state->block.index_count += new_quads * 6;
+        }
+        else
+        {
+            state->block.vertex_count += new_quads * 6;
+        }
+        glyphs_left -= processed;
+
+        if(max_seconds > 0.f && __private_vtxt_seconds() >= end_time)
+        {
+            break;
+        }
+    }
+    return state->done;
+}
+
+VTXT_DEF int
+vtxt_layout_next_chunk(vtxt_layout_state* state, float* vertices, unsigned int* indices, int max_quads)
+{
+    // Every character makes at most one quad, so asking for as many characters as there is room
+    // left for quads can never overflow the chunk, and repeating that fills it up exactly
+    int quad_count = 0;
+    while(!state->done && quad_count < max_quads)
+    {
+        int processed;
+        int new_quads = __private_vtxt_layout_glyphs(state, vertices + quad_count * (state->indexed ? 16 : 24),
+                                                     max_quads - quad_count, &processed);
+        if(state->indexed)
+        {
+            __private_vtxt_index_block_quads(vertices, indices, quad_count, new_quads);
+        }
+        quad_count += new_quads;
+    }
+    return quad_count;
+}
+
+VTXT_DEF void
+vtxt_free_text_block(vtxt_text_block* block)
+{
+    if(block->other_form != NULL)
+    {
+        vtxt_free_text_block(block->other_form);
+        free(block->other_form);
+    }
+    free(block->vertices);
+    free(block->indices);
+    block->vertices = NULL;
+    block->indices = NULL;
+    block->other_form = NULL;
+    block->vertex_count = 0;
+    block->index_count = 0;
+}
+
+/** Copies block into converted with indices (4 vertices per quad) or without (6 vertices per quad), for
+    appending a block made with the other VTXT_CREATE_INDEX_BUFFER setting. Free it with vtxt_free_text_block.
+*/
+_vtxt_internal void
+__private_vtxt_convert_block(const vtxt_text_block* block, int indexed, vtxt_text_block* converted)
+{
+    int quad_count = block->indexed ? block->vertex_count / 4 : block->vertex_count / 6;
+    *converted = *block;
+    converted->indexed = indexed;
+    converted->other_form = NULL;
+    converted->vertices = (float*) malloc(sizeof(float) * 4 * 6 * (size_t) (quad_count + 1));
+    converted->indices = NULL;
+    if(indexed)
+    {
+        converted->indices = (unsigned int*) malloc(sizeof(unsigned int) * 6 * (size_t) (quad_count + 1));
+        memcpy(converted->vertices, block->vertices, sizeof(float) * 4 * (size_t) block->vertex_count);
+        __private_vtxt_index_block_quads(converted->vertices, converted->indices, 0, quad_count);
+        converted->vertex_count = quad_count * 4;
+        converted->index_count = quad_count * 6;
+    }
+    else
+    {
+        // Corners are left-bot, left-top, right-top, right-bot, as triangles in the order vtxt_append_line writes them
+        static const int triangles_order[6] = { 0, 2, 1, 3, 2, 0 };
+        for(int q = 0; q < quad_count; ++q)
+        {
+            for(int i = 0; i < 6; ++i)
+            {
+                memcpy(converted->vertices + (q * 6 + i) * 4, block->vertices + (q * 4 + triangles_order[i]) * 4, sizeof(float) * 4);
+            }
+        }
+        converted->vertex_count = quad_count * 6;
+        converted->index_count = 0;
+    }
+}
+
+VTXT_DEF void
+vtxt_append_text_block_instances(vtxt_text_block* block, const vtxt_text_instance* instances, int instance_count)
+{
+    if(block->indexed != ((_vtxt_config & VTXT_CREATE_INDEX_BUFFER) != 0) && block->vertex_count > 0)
+    {
+        // Convert once and keep it; only a block that has grown since (a layout in progress) is converted again
+        int quad_count = block->indexed ? block->vertex_count / 4 : block->vertex_count / 6;
+        vtxt_text_block* other = block->other_form;
+        if(other == NULL || (other->indexed ? other->vertex_count / 4 : other->vertex_count / 6) != quad_count)
+        {
+            if(other == NULL)
+            {
+                other = (vtxt_text_block*) malloc(sizeof(vtxt_text_block));
+                block->other_form = other;
+            }
+            else
+            {
+                vtxt_free_text_block(other);
+            }
+            __private_vtxt_convert_block(block, !block->indexed, other);
+        }
+        vtxt_append_text_block_instances(other, instances, instance_count);
+        return;
+    }
+
+    int vertices_per_instance = block->vertex_count;
+    int indices_per_instance = block->index_count;
+    // VTXT_TRACK_DAMAGE: every instance is the block's own bounds and hash moved by its affine map,
+    // both taken from the block's vertices in CPU memory
+    _vtxt_damage_accum block_damage;
+    __private_vtxt_damage_reset(&block_damage);
+    if(__private_vtxt_damage_accum())
+    {
+        for(int v = 0; v < vertices_per_instance; ++v)
+        {
+            const float* vertex = block->vertices + v * 4;
+            unsigned int words[4];
+            memcpy(words, vertex, sizeof(words));
+            __private_vtxt_damage_add(&block_damage, words, 4, vertex[0], vertex[1], vertex[0], vertex[1]);
+        }
+    }
+    for(int inst = 0; inst < instance_count; ++inst)
+    {
+        if(!__private_vtxt_has_room(vertices_per_instance, indices_per_instance)) // Make sure we are not exceeding the array size
+        {
+            break;
+        }
+
+        // Every vertex is transformed by the same affine map: xy' = xy * a + b (uv passes through)
+        __private_vtxt_damage_begin();
+        vtxt_text_instance instance = instances[inst];
+        float ax = instance.scale;
+        float ay = instance.scale;
+        float bx = instance.x;
+        float by = instance.y;
+        if(_vtxt_config & VTXT_USE_CLIPSPACE_COORDS)
+        {
+            ax = 2.f * instance.scale / _vtxt_screen_w_for_clipspace;
+            bx = 2.f * instance.x / _vtxt_screen_w_for_clipspace - 1.f;
+            ay = -2.f * instance.scale / _vtxt_screen_h_for_clipspace;
+            by = 1.f - 2.f * instance.y / _vtxt_screen_h_for_clipspace;
+        }
+
+        const float* src = block->vertices;
+        if(_vtxt_layout_is_default)
+        {
+            float* dst = (float*) _vtxt_vertex_output + _vtxt_vertex_count * 4;
+#ifdef VTXT_SSE2
+            __m128 mul = _mm_setr_ps(ax, ay, 1.f, 1.f);
+            __m128 add = _mm_setr_ps(bx, by, 0.f, 0.f);
+            if(__private_vtxt_streaming())
+            {
+                for(int v = 0; v < vertices_per_instance; ++v)
+                {
+                    __private_vtxt_stream_vertex(&_vtxt_stream, _vtxt_vertex_count + v, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + v * 4), mul), add));
+                }
+            }
+            else
+            {
+                for(int v = 0; v < vertices_per_instance; ++v)
+                {
+                    _mm_storeu_ps(dst + v * 4, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + v * 4), mul), add));
+                }
+            }
+#else
+            for(int v = 0; v < vertices_per_instance; ++v)
+            {
+                dst[v * 4 + 0] = src[v * 4 + 0] * ax + bx;
+                dst[v * 4 + 1] = src[v * 4 + 1] * ay + by;
+                dst[v * 4 + 2] = src[v * 4 + 2];
+                dst[v * 4 + 3] = src[v * 4 + 3];
+            }
+#endif
+        }
+        else
+        {
+            unsigned char* dst = _vtxt_vertex_output + (size_t) _vtxt_vertex_count * (size_t) _vtxt_layout.stride;
+            for(int v = 0; v < vertices_per_instance; ++v)
+            {
+                __private_vtxt_write_vertex(dst + v * _vtxt_layout.stride,
+                                            src[v * 4 + 0] * ax + bx, src[v * 4 + 1] * ay + by,
+                                            src[v * 4 + 2], src[v * 4 + 3], instance.color, block->page);
+            }
+        }
+
+        for(int i = 0; i < indices_per_instance; ++i)
+        {
+            _vtxt_index_buffer[_vtxt_index_count + i] = block->indices[i] + _vtxt_vertex_count;
+        }
+        if(_vtxt_config & VTXT_CREATE_COLOR_BUFFER)
+        {
+            for(int v = 0; v < vertices_per_instance; ++v)
+            {
+                _vtxt_color_buffer[_vtxt_vertex_count + v] = instance.color;
+            }
+        }
+
+        if(__private_vtxt_damage_accum())
+        {
+            float x0 = block_damage.min_x * instance.scale + instance.x;
+            float y0 = block_damage.min_y * instance.scale + instance.y;
+            float x1 = block_damage.max_x * instance.scale + instance.x;
+            float y1 = block_damage.max_y * instance.scale + instance.y;
+            float placement[3] = { instance.x, instance.y, instance.scale };
+            float anchor[4] = { 0.f, 0.f, 0.f, 0.f };
+            if(_vtxt_layout.anchor.format != VTXT_FORMAT_NONE)
+            {
+                memcpy(anchor, _vtxt_anchor, sizeof(anchor));
+            }
+            unsigned int words[11];
+            words[0] = (unsigned int) block_damage.hash;
+            words[1] = (unsigned int) (block_damage.hash >> 32);
+            memcpy(words + 2, placement, sizeof(placement));
+            words[5] = instance.color;
+            words[6] = (unsigned int) block->page;
+            memcpy(words + 7, anchor, sizeof(anchor));
+            __private_vtxt_damage_add(&_vtxt_damage, words, 11, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                                      x0 < x1 ? x1 : x0, y0 < y1 ? y1 : y0);
+        }
+
+        _vtxt_vertex_count += vertices_per_instance;
+        _vtxt_index_count += indices_per_instance;
+        __private_vtxt_damage_end();
+    }
+}
+
+/** Returns how far vtxt_append_line moves the cursor for line (up to the first '\n' or '\0'): the glyph
+    advances summed, with tabs moving to the next tab stop from the start of the line. */
+_vtxt_internal float
+__private_vtxt_line_advance(const char* line, vtxt_font* font, int text_height_px)
+{
+    int x = 0;
+    if(font->monospace_advance > 0.f)
+    {
+        // Same steps as __private_vtxt_append_line_monospace: advance * glyph count between tabs
+        float scale = (float)text_height_px / (float)font->font_height_px;
+        int advance = (int) (font->monospace_advance * scale);
+        int glyphs_since_tab = 0;
+        for(; *line != '\0' && *line != '\n'; ++line)
+        {
+            int slot = font->glyph_map[(unsigned char) *line];
+            if(slot == VTXT_GLYPH_ACTION_TAB)
+            {
+                x = __private_vtxt_next_tab_stop(x + glyphs_since_tab * advance, font, text_height_px);
+                glyphs_since_tab = 0;
+            }
+            else if(slot < VTXT_GLYPH_ACTION_TAB)
+            {
+                ++glyphs_since_tab;
+            }
+        }
+        return (float) (x + glyphs_since_tab * advance);
+    }
+    for(; *line != '\0' && *line != '\n'; ++line)
+    {
+        x += __private_vtxt_advance_at(*line, x, font, text_height_px);
+    }
+    return (float) x;
+}
+
+VTXT_DEF void
+vtxt_append_line_align_right(const char* line_of_text, vtxt_font* font, int text_height_px)
+{
+    __private_vtxt_damage_begin();
+    int line_start_x = _vtxt_cursor_x;
+    float line_length = __private_vtxt_line_advance(line_of_text, font, text_height_px);
+    for (; *line_of_text != '\0' && *line_of_text != '\n'; ++line_of_text)
+    {
+        if (font->glyph_map[(unsigned char) *line_of_text] == VTXT_GLYPH_ACTION_TAB)
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+            continue;
+        }
+        if (!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+        {
+            break;
+        }
+        __private_vtxt_append_glyph(*line_of_text, font, text_height_px, -line_length);
+    }
+    while (*line_of_text != '\0' && *line_of_text != '\n')
+    {
+        ++line_of_text;
+    }
+
+    if (*line_of_text == '\n')
+    {
+        vtxt_new_line(line_start_x, font, text_height_px);
+        ++line_of_text;
+        vtxt_append_line_align_right(line_of_text, font, text_height_px);
+    }
+    else // terminate
+    {
+
+    }
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF void
+vtxt_append_line_centered(const char* line_of_text, vtxt_font* font, int text_height_px)
+{
+    __private_vtxt_damage_begin();
+    int line_start_x = _vtxt_cursor_x;
+    float line_length = __private_vtxt_line_advance(line_of_text, font, text_height_px);
+    float half_line_length = line_length/2.f;
+    for(; *line_of_text != '\0' && *line_of_text != '\n'; ++line_of_text)
+    {
+        if(font->glyph_map[(unsigned char) *line_of_text] == VTXT_GLYPH_ACTION_TAB)
+        {
+            __private_vtxt_tab(line_start_x, font, text_height_px);
+            continue;
+        }
+        if(!__private_vtxt_has_room_for_quad()) // Make sure we are not exceeding the array size
+        {
+            break;
+        }
+        __private_vtxt_append_glyph(*line_of_text, font, text_height_px, -half_line_length);
+    }
+    while(*line_of_text != '\0' && *line_of_text != '\n')
+    {
+        ++line_of_text;
+    }
+
+    if(*line_of_text == '\n')
+    {
+        vtxt_new_line(line_start_x, font, text_height_px);
+        ++line_of_text;
+        vtxt_append_line_centered(line_of_text, font, text_height_px);
+    }
+    else // terminate
+    {
+
+    }
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF void
+vtxt_get_text_bounding_box_info(float* width_out,
+                                float* height_out,
+                                const char* text,
+                                vtxt_font* font,
+                                int text_height_px)
+{
+    float wSumLargestSoFar = 0;
+    float wSumCurrent = 0;
+    float hSum = 0;
+
+    if (font->monospace_advance > 0.f)
+    {
+        // Every glyph but the last in a line is exactly one advance wide, so a line's width only depends
+        // on where its tabs move the cursor, its glyph counts between them and its last glyph
+        float scale = (float)text_height_px / (float)font->font_height_px;
+        float linegap = font->linegap + _vtxt_linegap_offset;
+        int advance = (int) (font->monospace_advance * scale);
+        while (*text != '\0')
+        {
+            int glyph_count = 0;
+            int last_slot = 0;
+            int last_x = 0;
+            int tab_x = 0;
+            int glyphs_since_tab = 0;
+            while (*text != '\0' && *text != '\n')
+            {
+                int slot = font->glyph_map[(unsigned char)*text];
+                if (slot == VTXT_GLYPH_ACTION_TAB)
+                {
+                    tab_x = __private_vtxt_next_tab_stop(tab_x + glyphs_since_tab * advance, font, text_height_px);
+                    glyphs_since_tab = 0;
+                }
+                else if (slot < VTXT_GLYPH_ACTION_TAB)
+                {
+                    last_x = tab_x + glyphs_since_tab * advance;
+                    ++glyphs_since_tab;
+                    ++glyph_count;
+                    last_slot = slot;
+                }
+                ++text;
+            }
+            if (glyph_count > 0)
+            {
+                vtxt_glyph glyph = font->glyphs[last_slot];
+                wSumCurrent = (float)last_x + (glyph.offset_x + glyph.width) * scale;
+                if (wSumCurrent > wSumLargestSoFar)
+                {
+                    wSumLargestSoFar = wSumCurrent;
+                }
+                hSum += (font->ascender - font->descender + linegap) * scale;
+            }
+            if (*text == '\n')
+            {
+                ++text;
+            }
+        }
+        *width_out = wSumLargestSoFar;
+        *height_out = hSum;
+        return;
+    }
+
+    int pen_x = 0; // cursor relative to the line start, moved like vtxt_append_line moves it
+    while (*text != '\0')
+    {
+        if (*text == '\n')
+        {
+            pen_x = 0;
+        }
+        else
+        {
+            int slot = font->glyph_map[(unsigned char)*text];
+            if (slot >= VTXT_GLYPH_ACTION_TAB) // Nothing drawn for control characters, but tabs move the cursor
+            {
+                pen_x += __private_vtxt_advance_at(*text, pen_x, font, text_height_px);
+                ++text;
+                continue;
+            }
+
+            // Last if only control characters follow before the end of the line
+            const char* next = text + 1;
+            while (*next != '\0' && *next != '\n' && font->glyph_map[(unsigned char)*next] >= VTXT_GLYPH_ACTION_TAB)
+            {
+                ++next;
+            }
+            bool isLastGlyphInLine = *next == '\0' || *next == '\n';
+            float scale = (float)text_height_px / (float)font->font_height_px;
+            vtxt_glyph glyph = font->glyphs[slot];
+            glyph.advance *= scale;
+            glyph.width *= scale;
+            glyph.height *= scale;
+            glyph.offset_x *= scale;
+            glyph.offset_y *= scale;
+
+            if (isLastGlyphInLine)
+            {
+                wSumCurrent = (float)pen_x + glyph.offset_x + glyph.width;
+                if (wSumCurrent > wSumLargestSoFar)
+                {
+                    wSumLargestSoFar = wSumCurrent;
+                }
+
+                float linegap = font->linegap + _vtxt_linegap_offset;
+                float heightOfThisLine = (font->ascender - font->descender + linegap) * scale;
+                // Note(Kevin): honestly could prob just use the tallest glyph.height + glyph.offset_y instead
+                // TODO(Kevin): Only add font->linegap if there is a new line with legit characters
+                hSum += heightOfThisLine;
+            }
+            pen_x += __private_vtxt_glyph_advance(*text, font, text_height_px);
+        }
+        ++text; // next character
+    }
+
+    *width_out = wSumLargestSoFar;
+    *height_out = hSum;
+}
+
+/** Divides a product of two 0..255 values by 255, rounded (exact for 0..65025). */
+#define _vtxt_div255(x) (((x) + 128 + (((x) + 128) >> 8)) >> 8)
+
+/** Blends count pixels of a 1 channel image towards the color's red channel, by coverage * color alpha. */
+_vtxt_internal void
+__private_vtxt_blend_span_gray(unsigned char* dst, const unsigned char* coverage, int count, unsigned int color)
+{
+    unsigned int value = color & 0xFF;
+    unsigned int alpha = color >> 24;
+    int i = 0;
+#ifdef VTXT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i value16 = _mm_set1_epi16((short) value);
+    const __m128i alpha16 = _mm_set1_epi16((short) alpha);
+    #define _vtxt_div255_epi16(x) _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16((x), bias), _mm_srli_epi16(_mm_add_epi16((x), bias), 8)), 8)
+    for(; i + 16 <= count; i += 16)
+    {
+        __m128i c = _mm_loadu_si128((const __m128i*) (coverage + i));
+        __m128i d = _mm_loadu_si128((const __m128i*) (dst + i));
+        __m128i out[2];
+        for(int half = 0; half < 2; ++half)
+        {
+            __m128i c16 = half ? _mm_unpackhi_epi8(c, zero) : _mm_unpacklo_epi8(c, zero);
+            __m128i d16 = half ? _mm_unpackhi_epi8(d, zero) : _mm_unpacklo_epi8(d, zero);
+            __m128i a16 = _vtxt_div255_epi16(_mm_mullo_epi16(c16, alpha16));
+            __m128i sum = _mm_add_epi16(_mm_mullo_epi16(d16, _mm_sub_epi16(full, a16)), _mm_mullo_epi16(value16, a16));
+            out[half] = _vtxt_div255_epi16(sum);
+        }
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_packus_epi16(out[0], out[1]));
+    }
+#endif
+    for(; i < count; ++i)
+    {
+        unsigned int a = _vtxt_div255(coverage[i] * alpha);
+        dst[i] = (unsigned char) _vtxt_div255(dst[i] * (255 - a) + value * a);
+    }
+}
+
+/** Blends count RGBA8 pixels towards color (packed RGBA8) by coverage * color alpha, straight alpha "over". */
+_vtxt_internal void
+__private_vtxt_blend_span_rgba(unsigned char* dst, const unsigned char* coverage, int count, unsigned int color)
+{
+    unsigned int rgb[3] = { color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF };
+    unsigned int alpha = color >> 24;
+    int i = 0;
+#ifdef VTXT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alpha16 = _mm_set1_epi16((short) alpha);
+    const __m128i color16 = _mm_setr_epi16((short) rgb[0], (short) rgb[1], (short) rgb[2], 255,
+                                           (short) rgb[0], (short) rgb[1], (short) rgb[2], 255);
+    for(; i + 4 <= count; i += 4)
+    {
+        // 4 pixels: per pixel alpha, spread to its 4 channels, then the same blend as the gray span
+        int c4;
+        memcpy(&c4, coverage + i, 4);
+        __m128i c16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(c4), zero);
+        __m128i a16 = _vtxt_div255_epi16(_mm_mullo_epi16(c16, alpha16));
+        a16 = _mm_unpacklo_epi16(a16, a16);
+        __m128i d = _mm_loadu_si128((const __m128i*) (dst + i * 4));
+        __m128i out[2];
+        for(int half = 0; half < 2; ++half)
+        {
+            __m128i a = half ? _mm_unpackhi_epi32(a16, a16) : _mm_unpacklo_epi32(a16, a16);
+            __m128i d16 = half ? _mm_unpackhi_epi8(d, zero) : _mm_unpacklo_epi8(d, zero);
+            __m128i sum = _mm_add_epi16(_mm_mullo_epi16(d16, _mm_sub_epi16(full, a)), _mm_mullo_epi16(color16, a));
+            out[half] = _vtxt_div255_epi16(sum);
+        }
+        _mm_storeu_si128((__m128i*) (dst + i * 4), _mm_packus_epi16(out[0], out[1]));
+    }
+    #undef _vtxt_div255_epi16
+#endif
+    for(; i < count; ++i)
+    {
+        unsigned int a = _vtxt_div255(coverage[i] * alpha);
+        unsigned char* p = dst + i * 4;
+        p[0] = (unsigned char) _vtxt_div255(p[0] * (255 - a) + rgb[0] * a);
+        p[1] = (unsigned char) _vtxt_div255(p[1] * (255 - a) + rgb[1] * a);
+        p[2] = (unsigned char) _vtxt_div255(p[2] * (255 - a) + rgb[2] * a);
+        p[3] = (unsigned char) _vtxt_div255(p[3] * (255 - a) + 255 * a);
+    }
+}
+
+/** Everything a blit task needs. Each task owns a band of rows, so tasks never write the same pixel. */
+typedef struct _vtxt_blit_job
+{
+    const vtxt_bitmap*  atlas;
+    vtxt_image*         target;
+    vtxt_rect           clip;
+    int                 quad_count;
+    int                 vertices_per_quad;
+    int                 right_top_vertex;   // which vertex of a quad is the right-top corner (left-bot is 0)
+} _vtxt_blit_job;
+
+/** Reads the color of a vertex: the color buffer, else the vertex layout's packed color, else the current color. */
+_vtxt_internal unsigned int
+__private_vtxt_vertex_color(int vertex)
+{
+    unsigned int color = _vtxt_color;
+    if(_vtxt_config & VTXT_CREATE_COLOR_BUFFER)
+    {
+        color = _vtxt_color_buffer[vertex];
+    }
+    else if(_vtxt_layout.color.format == VTXT_FORMAT_UINT32)
+    {
+        memcpy(&color, _vtxt_vertex_output + (size_t) vertex * (size_t) _vtxt_layout.stride + _vtxt_layout.color.offset, sizeof(color));
+    }
+    return color;
+}
+
+/** Reads the texture coordinates of a vertex in the vertex output. */
+_vtxt_internal void
+__private_vtxt_read_uv(int vertex, float uv[2])
+{
+    const unsigned char* src = _vtxt_vertex_output + (size_t) vertex * (size_t) _vtxt_layout.stride + _vtxt_layout.uv.offset;
+    if(_vtxt_layout.uv.format == VTXT_FORMAT_UNORM16x2)
+    {
+        unsigned short values[2];
+        memcpy(values, src, sizeof(values));
+        uv[0] = (float) values[0] / 65535.f;
+        uv[1] = (float) values[1] / 65535.f;
+    }
+    else
+    {
+        memcpy(uv, src, sizeof(float) * 2);
+    }
+}
+
+_vtxt_internal void
+__private_vtxt_blit_band(void* task_data, int task_index)
+{
+    _vtxt_blit_job* job = (_vtxt_blit_job*) task_data;
+    const vtxt_bitmap* atlas = job->atlas;
+    vtxt_image* target = job->target;
+    int band_y0 = job->clip.y0 + task_index * VTXT_BLIT_TILE_ROWS;
+    int band_y1 = band_y0 + VTXT_BLIT_TILE_ROWS < job->clip.y1 ? band_y0 + VTXT_BLIT_TILE_ROWS : job->clip.y1;
+    unsigned char coverage[256];
+
+    for(int q = 0; q < job->quad_count; ++q)
+    {
+        // Left-bot and right-top corners give the quad's screen rect and its atlas rect
+        int lb = q * job->vertices_per_quad;
+        int rt = lb + job->right_top_vertex;
+        float p0[2], p1[2], t0[2], t1[2];
+        __private_vtxt_read_position(lb, p0);
+        __private_vtxt_read_position(rt, p1);
+        float min_y = p0[1] < p1[1] ? p0[1] : p1[1];
+        float max_y = p0[1] < p1[1] ? p1[1] : p0[1];
+        // Pixels whose centers are inside the quad
+        int py0 = _vtxt_ceil(min_y - 0.5f);
+        int py1 = _vtxt_ceil(max_y - 0.5f);
+        py0 = py0 > band_y0 ? py0 : band_y0;
+        py1 = py1 < band_y1 ? py1 : band_y1;
+        if(py0 >= py1 || p0[0] == p1[0])
+        {
+            continue;
+        }
+        float min_x = p0[0] < p1[0] ? p0[0] : p1[0];
+        float max_x = p0[0] < p1[0] ? p1[0] : p0[0];
+        int px0 = _vtxt_ceil(min_x - 0.5f);
+        int px1 = _vtxt_ceil(max_x - 0.5f);
+        px0 = px0 > job->clip.x0 ? px0 : job->clip.x0;
+        px1 = px1 < job->clip.x1 ? px1 : job->clip.x1;
+        if(px0 >= px1)
+        {
+            continue;
+        }
+        __private_vtxt_read_uv(lb, t0);
+        __private_vtxt_read_uv(rt, t1);
+        unsigned int color = __private_vtxt_vertex_color(lb);
+
+        // Atlas texel position as a linear function of the pixel center: s = s_at_0 + (px + 0.5) * s_step
+        float s_step = (t1[0] - t0[0]) * (float) atlas->width / (p1[0] - p0[0]);
+        float s_at_0 = t0[0] * (float) atlas->width - p0[0] * s_step;
+        float t_step = (t1[1] - t0[1]) * (float) atlas->height / (p1[1] - p0[1]);
+        float t_at_0 = t0[1] * (float) atlas->height - p0[1] * t_step;
+        int unscaled = s_step > 0.999f && s_step < 1.001f;
+        int first_col = (int) (s_at_0 + ((float) px0 + 0.5f) * s_step);
+        if(unscaled && (first_col < 0 || first_col + (px1 - px0) > atlas->width))
+        {
+            unscaled = 0;
+        }
+
+        for(int py = py0; py < py1; ++py)
+        {
+            int row = (int) (t_at_0 + ((float) py + 0.5f) * t_step);
+            row = row < 0 ? 0 : (row >= atlas->height ? atlas->height - 1 : row);
+            const unsigned char* atlas_row = atlas->pixels + (size_t) row * (size_t) atlas->width;
+            unsigned char* dst_row = target->pixels + (size_t) py * (size_t) target->stride + (size_t) px0 * (size_t) target->channels;
+            for(int x = px0; x < px1; x += 256)
+            {
+                int count = px1 - x < 256 ? px1 - x : 256;
+                const unsigned char* src = coverage;
+                if(unscaled)
+                {
+                    src = atlas_row + first_col + (x - px0);
+                }
+                else
+                {
+                    // Scaled or mirrored quad: nearest texel per pixel
+                    for(int i = 0; i < count; ++i)
+                    {
+                        int col = (int) (s_at_0 + ((float) (x + i) + 0.5f) * s_step);
+                        col = col < 0 ? 0 : (col >= atlas->width ? atlas->width - 1 : col);
+                        coverage[i] = atlas_row[col];
+                    }
+                }
+                unsigned char* dst = dst_row + (size_t) (x - px0) * (size_t) target->channels;
+                if(target->channels == 4)
+                {
+                    __private_vtxt_blend_span_rgba(dst, src, count, color);
+                }
+                else
+                {
+                    __private_vtxt_blend_span_gray(dst, src, count, color);
+                }
+            }
+        }
+    }
+}
+
+VTXT_DEF void
+vtxt_blit_buffer(const vtxt_font* font, vtxt_image* image, const vtxt_rect* clip,
+                 vtxt_parallel_for_fn parallel_for, void* user_data)
+{
+    __private_vtxt_flush_stores(); // the quads are read back from the vertex output
+    _vtxt_blit_job job;
+    job.atlas = &font->font_atlas;
+    job.target = image;
+    job.clip.x0 = 0;
+    job.clip.y0 = 0;
+    job.clip.x1 = image->width;
+    job.clip.y1 = image->height;
+    if(clip)
+    {
+        job.clip.x0 = clip->x0 > 0 ? clip->x0 : 0;
+        job.clip.y0 = clip->y0 > 0 ? clip->y0 : 0;
+        job.clip.x1 = clip->x1 < image->width ? clip->x1 : image->width;
+        job.clip.y1 = clip->y1 < image->height ? clip->y1 : image->height;
+    }
+    job.vertices_per_quad = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) ? 4 : 6;
+    job.right_top_vertex = (_vtxt_config & VTXT_CREATE_INDEX_BUFFER) ? 2 : 1;
+    job.quad_count = _vtxt_vertex_count / job.vertices_per_quad;
+    if(job.clip.x0 >= job.clip.x1 || job.clip.y0 >= job.clip.y1)
+    {
+        return;
+    }
+
+    int band_count = (job.clip.y1 - job.clip.y0 + VTXT_BLIT_TILE_ROWS - 1) / VTXT_BLIT_TILE_ROWS;
+    if(parallel_for && band_count > 1)
+    {
+        parallel_for(__private_vtxt_blit_band, &job, band_count, user_data);
+    }
+    else
+    {
+        for(int band = 0; band < band_count; ++band)
+        {
+            __private_vtxt_blit_band(&job, band);
+        }
+    }
+}
+
+#undef _vtxt_div255
+
+_vtxt_internal int
+__private_vtxt_compare_damage_blocks(const void* a, const void* b)
+{
+    unsigned long long ha = ((const _vtxt_damage_block*) a)->hash;
+    unsigned long long hb = ((const _vtxt_damage_block*) b)->hash;
+    return (ha > hb) - (ha < hb);
+}
+
+/** Adds r to the damage list, merging it with every rect it overlaps. When the list is full, r is
+    merged into the rect whose area grows the least. */
+_vtxt_internal void
+__private_vtxt_add_damage_rect(vtxt_rect* rects, int* count, int max_rects, vtxt_rect r)
+{
+    for(;;)
+    {
+        int merged = 0;
+        for(int i = 0; i < *count; ++i)
+        {
+            if(rects[i].x0 < r.x1 && r.x0 < rects[i].x1 && rects[i].y0 < r.y1 && r.y0 < rects[i].y1)
+            {
+                r = __private_vtxt_rect_union(r, rects[i]);
+                rects[i] = rects[--*count];
+                merged = 1;
+                break;
+            }
+        }
+        if(merged)
+        {
+            continue;
+        }
+        if(*count < max_rects)
+        {
+            rects[(*count)++] = r;
+            return;
+        }
+        int best = 0;
+        long long best_growth = 0;
+        for(int i = 0; i < *count; ++i)
+        {
+            vtxt_rect u = __private_vtxt_rect_union(r, rects[i]);
+            long long growth = (long long)(u.x1 - u.x0) * (u.y1 - u.y0) - (long long)(rects[i].x1 - rects[i].x0) * (rects[i].y1 - rects[i].y0);
+            if(i == 0 || growth < best_growth)
+            {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        r = __private_vtxt_rect_union(r, rects[best]);
+        rects[best] = rects[--*count];
+    }
+}
+
+VTXT_DEF int
+vtxt_grab_damage(vtxt_rect* rects_out, int max_rects)
+{
+    int current = _vtxt_damage_frame;
+    int previous = !current;
+    _vtxt_damage_block* a = _vtxt_damage_blocks[current];
+    _vtxt_damage_block* b = _vtxt_damage_blocks[previous];
+    int a_count = _vtxt_damage_block_count[current];
+    int b_count = _vtxt_damage_block_count[previous];
+    int rect_count = 0;
+
+    // A block is undamaged if an identical block (same hash) was drawn last frame. Sort both frames by
+    // hash and walk them side by side: whatever is only in one of them was added, removed or changed.
+    qsort(a, (size_t) a_count, sizeof(_vtxt_damage_block), __private_vtxt_compare_damage_blocks);
+    qsort(b, (size_t) b_count, sizeof(_vtxt_damage_block), __private_vtxt_compare_damage_blocks);
+    int i = 0;
+    int j = 0;
+    while(i < a_count || j < b_count)
+    {
+        if(j == b_count || (i < a_count && a[i].hash < b[j].hash))
+        {
+            __private_vtxt_add_damage_rect(rects_out, &rect_count, max_rects, a[i++].bounds);
+        }
+        else if(i == a_count || b[j].hash < a[i].hash)
+        {
+            __private_vtxt_add_damage_rect(rects_out, &rect_count, max_rects, b[j++].bounds);
+        }
+        else
+        {
+            ++i;
+            ++j;
+        }
+    }
+    for(int frame = 0; frame < 2; ++frame)
+    {
+        if(_vtxt_damage_overflowed[frame])
+        {
+            __private_vtxt_add_damage_rect(rects_out, &rect_count, max_rects, _vtxt_damage_overflow[frame]);
+        }
+    }
+
+    // This frame becomes the one the next frame is compared against
+    _vtxt_damage_frame = previous;
+    _vtxt_damage_block_count[previous] = 0;
+    _vtxt_damage_overflowed[previous] = 0;
+    return rect_count;
+}
+
+// Atomics for the dynamic atlas, which is read by layout while misses are being inserted
+#if defined(_MSC_VER) && !defined(__clang__)
+_vtxt_internal int
+__private_vtxt_atomic_load(int* value)
+{
+    return (int) _InterlockedOr((volatile long*) value, 0);
+}
+
+_vtxt_internal void
+__private_vtxt_atomic_store(int* value, int new_value)
+{
+    _InterlockedExchange((volatile long*) value, (long) new_value);
+}
+
+_vtxt_internal int
+__private_vtxt_atomic_add(int* value, int amount)
+{
+    return (int) _InterlockedExchangeAdd((volatile long*) value, (long) amount);
+}
+
+/** Sets *value to desired if it is *expected and returns 1, otherwise loads *value into *expected and returns 0. */
+_vtxt_internal int
+__private_vtxt_atomic_cas(int* value, int* expected, int desired)
+{
+    long old = _InterlockedCompareExchange((volatile long*) value, (long) desired, (long) *expected);
+    if(old == (long) *expected)
+    {
+        return 1;
+    }
+    *expected = (int) old;
+    return 0;
+}
+
+_vtxt_internal unsigned long long
+__private_vtxt_atomic_load64(unsigned long long* value)
+{
+    return (unsigned long long) _InterlockedCompareExchange64((volatile __int64*) value, 0, 0);
+}
+
+_vtxt_internal int
+__private_vtxt_atomic_cas64(unsigned long long* value, unsigned long long* expected, unsigned long long desired)
+{
+    __int64 old = _InterlockedCompareExchange64((volatile __int64*) value, (__int64) desired, (__int64) *expected);
+    if(old == (__int64) *expected)
+    {
+        return 1;
+    }
+    *expected = (unsigned long long) old;
+    return 0;
+}
+#else
+_vtxt_internal int
+__private_vtxt_atomic_load(int* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+_vtxt_internal void
+__private_vtxt_atomic_store(int* value, int new_value)
+{
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+}
+
+_vtxt_internal int
+__private_vtxt_atomic_add(int* value, int amount)
+{
+    return __atomic_fetch_add(value, amount, __ATOMIC_ACQ_REL);
+}
+
+/** Sets *value to desired if it is *expected and returns 1, otherwise loads *value into *expected and returns 0. */
+_vtxt_internal int
+__private_vtxt_atomic_cas(int* value, int* expected, int desired)
+{
+    return __atomic_compare_exchange_n(value, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+_vtxt_internal unsigned long long
+__private_vtxt_atomic_load64(unsigned long long* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+_vtxt_internal int
+__private_vtxt_atomic_cas64(unsigned long long* value, unsigned long long* expected, unsigned long long desired)
+{
+    return __atomic_compare_exchange_n(value, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+/** Decodes the UTF-8 sequence at *text and moves *text past it. Malformed sequences decode to U+FFFD one
+    byte at a time. */
+_vtxt_internal int
+__private_vtxt_decode_utf8(const char** text)
+{
+    const unsigned char* s = (const unsigned char*) *text;
+    int length = s[0] < 0x80 ? 1 : s[0] < 0xC2 ? 0 : s[0] < 0xE0 ? 2 : s[0] < 0xF0 ? 3 : s[0] < 0xF5 ? 4 : 0;
+    int codepoint = length == 1 ? s[0] : length == 2 ? s[0] & 0x1F : length == 3 ? s[0] & 0x0F : s[0] & 0x07;
+    for(int i = 1; i < length; ++i)
+    {
+        if((s[i] & 0xC0) != 0x80)
+        {
+            length = 0;
+            break;
+        }
+        codepoint = (codepoint << 6) | (s[i] & 0x3F);
+    }
+    if(length == 0 || (length == 3 && (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF)))
+       || (length == 4 && (codepoint < 0x10000 || codepoint > 0x10FFFF)))
+    {
+        *text += 1;
+        return 0xFFFD;
+    }
+    *text += length;
+    return codepoint;
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_init(vtxt_dynamic_atlas* atlas, unsigned char* font_buffer, int font_height_px,
+                        int atlas_width, int atlas_height, int max_glyphs)
+{
+    memset(atlas, 0, sizeof(*atlas));
+    stbtt_fontinfo* info = (stbtt_fontinfo*) malloc(sizeof(stbtt_fontinfo));
+    if(!stbtt_InitFont(info, font_buffer, 0))
+    {
+        free(info);
+        return 0;
+    }
+    atlas->font_info = info;
+    atlas->font_scale = stbtt_ScaleForMappingEmToPixels(info, (float) font_height_px);
+    atlas->font_height_px = font_height_px;
+    int ascender, descender, linegap;
+    stbtt_GetFontVMetrics(info, &ascender, &descender, &linegap);
+    atlas->shelf_height = _vtxt_ceil((float) (ascender - descender) * atlas->font_scale) + VTXT_ATLAS_PAD_Y;
+    atlas->page = 1;
+    atlas->spare_page = 2;
+    atlas->atlas.width = atlas_width;
+    atlas->atlas.height = atlas_height;
+    atlas->atlas.pixels = (unsigned char*) calloc((size_t) atlas_width * (size_t) atlas_height, 1);
+
+    // At most half full, so probe sequences stay short
+    atlas->capacity = 16;
+    while(atlas->capacity < 2 * max_glyphs)
+    {
+        atlas->capacity *= 2;
+    }
+    atlas->keys = (int*) calloc((size_t) atlas->capacity, sizeof(int));
+    atlas->ready = (int*) calloc((size_t) atlas->capacity, sizeof(int));
+    atlas->queued = (int*) calloc((size_t) atlas->capacity, sizeof(int));
+    atlas->last_used = (int*) calloc((size_t) atlas->capacity, sizeof(int));
+    atlas->glyphs = (vtxt_glyph*) calloc((size_t) atlas->capacity * 2, sizeof(vtxt_glyph));
+    atlas->glyph_pages = (int*) calloc((size_t) atlas->capacity * 2, sizeof(int));
+    atlas->misses = (int*) malloc(sizeof(int) * (size_t) atlas->capacity);
+    for(int i = 0; i < atlas->capacity; ++i)
+    {
+        atlas->misses[i] = -1;
+    }
+    atlas->max_glyphs = max_glyphs;
+    atlas->dirty.x0 = atlas->dirty.y0 = atlas->dirty.x1 = atlas->dirty.y1 = 0;
+    return 1;
+}
+
+VTXT_DEF void
+vtxt_dynamic_atlas_free(vtxt_dynamic_atlas* atlas)
+{
+    free(atlas->font_info);
+    free(atlas->atlas.pixels);
+    free(atlas->old_atlas.pixels);
+    free(atlas->keys);
+    free(atlas->ready);
+    free(atlas->queued);
+    free(atlas->last_used);
+    free(atlas->glyphs);
+    free(atlas->glyph_pages);
+    free(atlas->misses);
+    free(atlas->compact_slots);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+/** Returns the slot of codepoint in the glyph table, inserting the key if it isn't there. -1 if the table
+    is full. Lock-free: a slot is claimed by the one thread whose compare-and-swap puts the key in, and
+    everyone else sees that key from then on. Keys are never removed, evicted glyphs keep their slot. */
+_vtxt_internal int
+__private_vtxt_dynamic_slot(vtxt_dynamic_atlas* atlas, int codepoint)
+{
+    int mask = atlas->capacity - 1;
+    int key = codepoint + 1;
+    int slot = (int) (((unsigned int) codepoint * 2654435761u) >> 8) & mask;
+    for(int probe = 0; probe < atlas->capacity; ++probe, slot = (slot + 1) & mask)
+    {
+        int existing = __private_vtxt_atomic_load(&atlas->keys[slot]);
+        if(existing == 0)
+        {
+            if(__private_vtxt_atomic_load(&atlas->key_count) >= atlas->max_glyphs)
+            {
+                return -1;
+            }
+            if(__private_vtxt_atomic_cas(&atlas->keys[slot], &existing, key))
+            {
+                __private_vtxt_atomic_add(&atlas->key_count, 1);
+                return slot;
+            }
+            // Lost the race for this slot, existing now holds the winner's key
+        }
+        if(existing == key)
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+VTXT_DEF const vtxt_glyph*
+vtxt_dynamic_atlas_glyph(vtxt_dynamic_atlas* atlas, int codepoint, int* page_out)
+{
+    int slot = __private_vtxt_dynamic_slot(atlas, codepoint);
+    if(slot < 0)
+    {
+        return NULL;
+    }
+    int state = __private_vtxt_atomic_load(&atlas->ready[slot]);
+    if(state > 0)
+    {
+        int frame = __private_vtxt_atomic_load(&atlas->frame);
+        if(__private_vtxt_atomic_load(&atlas->last_used[slot]) != frame) // don't bounce the cache line every lookup
+        {
+            __private_vtxt_atomic_store(&atlas->last_used[slot], frame);
+        }
+        *page_out = atlas->glyph_pages[slot * 2 + state - 1];
+        return &atlas->glyphs[slot * 2 + state - 1];
+    }
+
+    // Queue it once, whoever flips queued gets to push it
+    int not_queued = 0;
+    if(__private_vtxt_atomic_cas(&atlas->queued[slot], &not_queued, 1))
+    {
+        int miss = __private_vtxt_atomic_add(&atlas->miss_count, 1);
+        __private_vtxt_atomic_store(&atlas->misses[miss & (atlas->capacity - 1)], slot);
+    }
+    return NULL;
+}
+
+/** Claims a width x height rect of the atlas: on the current shelf if it fits there, otherwise at the
+    start of a new shelf below it. The current shelf (x, y and height, 20 bits each) is a single 64-bit value
+    updated with a compare-and-swap, so any number of threads can claim rects without locking.
+    Returns 0 if the atlas has no room left for it. */
+_vtxt_internal int
+__private_vtxt_claim_glyph_rect(vtxt_dynamic_atlas* atlas, int width, int height, int* x_out, int* y_out)
+{
+    unsigned long long shelf = __private_vtxt_atomic_load64(&atlas->shelf);
+    for(;;)
+    {
+        int x = (int) (shelf & 0xFFFFF);
+        int y = (int) ((shelf >> 20) & 0xFFFFF);
+        int pitch = (int) ((shelf >> 40) & 0xFFFFF);
+        if(x + width > atlas->atlas.width || height + VTXT_ATLAS_PAD_Y > pitch)
+        {
+            // New shelf, usually one line tall so that most glyphs fit next to each other
+            y += pitch;
+            x = 0;
+            pitch = height + VTXT_ATLAS_PAD_Y > atlas->shelf_height ? height + VTXT_ATLAS_PAD_Y : atlas->shelf_height;
+            if(width > atlas->atlas.width || y + height > atlas->atlas.height)
+            {
+                return 0;
+            }
+            pitch = y + pitch < atlas->atlas.height ? pitch : atlas->atlas.height - y;
+        }
+        unsigned long long claimed = (unsigned long long) (x + width + VTXT_ATLAS_PAD_X)
+                                     | ((unsigned long long) y << 20) | ((unsigned long long) pitch << 40);
+        if(__private_vtxt_atomic_cas64(&atlas->shelf, &shelf, claimed))
+        {
+            *x_out = x;
+            *y_out = y;
+            return 1;
+        }
+    }
+}
+
+/** Writes glyph with the uvs of its rect at (atlas_x, atlas_y) in atlas into the slot's record that isn't
+    live, and then makes that record live. A lookup that is still reading the other record is unaffected. */
+_vtxt_internal void
+__private_vtxt_publish_glyph(vtxt_dynamic_atlas* atlas, int slot, vtxt_glyph glyph, int atlas_x, int atlas_y)
+{
+    int state = atlas->ready[slot];
+    int record = state == 0 ? 0 : ((state > 0 ? state : -state) - 1) ^ 1;
+    glyph.min_u = (float) atlas_x / (float) atlas->atlas.width;
+    glyph.min_v = (float) atlas_y / (float) atlas->atlas.height;
+    glyph.max_u = (float) (atlas_x + (int) glyph.width) / (float) atlas->atlas.width;
+    glyph.max_v = (float) (atlas_y + (int) glyph.height) / (float) atlas->atlas.height;
+    atlas->glyphs[slot * 2 + record] = glyph;
+    atlas->glyph_pages[slot * 2 + record] = atlas->page;
+    __private_vtxt_atomic_store(&atlas->ready[slot], record + 1);
+}
+
+/** State shared by the tasks of one vtxt_dynamic_atlas_resolve. Task i rasterizes and inserts misses
+    [first + i * VTXT_MISSES_PER_TASK, ...) and reports the atlas pixels it wrote in written[i]. */
+typedef struct _vtxt_miss_job
+{
+    vtxt_dynamic_atlas* atlas;
+    int                 first;
+    int                 end;
+    vtxt_rect*          written;
+    int*                inserted;
+} _vtxt_miss_job;
+
+_vtxt_internal void
+__private_vtxt_resolve_misses_task(void* task_data, int task_index)
+{
+    _vtxt_miss_job* job = (_vtxt_miss_job*) task_data;
+    vtxt_dynamic_atlas* atlas = job->atlas;
+    const stbtt_fontinfo* info = (const stbtt_fontinfo*) atlas->font_info;
+    int first = job->first + task_index * VTXT_MISSES_PER_TASK;
+    int end = job->end - first < VTXT_MISSES_PER_TASK ? job->end : first + VTXT_MISSES_PER_TASK;
+    vtxt_rect written = { 0, 0, 0, 0 };
+    int inserted = 0;
+    for(int miss = first; miss < end; ++miss)
+    {
+        int slot = __private_vtxt_atomic_load(&atlas->misses[miss & (atlas->capacity - 1)]);
+        int codepoint = atlas->keys[slot] - 1;
+        if(__private_vtxt_atomic_load(&atlas->ready[slot]) > 0)
+        {
+            __private_vtxt_atomic_store(&atlas->queued[slot], 0); // queued again by a lookup that raced the last insert
+            continue;
+        }
+
+        // Claim space from the bitmap box first, so that a full atlas costs no rasterization
+        int x0, y0, x1, y1;
+        stbtt_GetCodepointBitmapBox(info, codepoint, atlas->font_scale, atlas->font_scale, &x0, &y0, &x1, &y1);
+        int atlas_x, atlas_y;
+        if(!__private_vtxt_claim_glyph_rect(atlas, x1 - x0, y1 - y0, &atlas_x, &atlas_y))
+        {
+            __private_vtxt_atomic_store(&atlas->full, 1);
+            __private_vtxt_atomic_store(&atlas->queued[slot], 0); // stays missing, asked for again on the next lookup
+            continue;
+        }
+
+        vtxt_glyph glyph;
+        int advance, left_bearing, width, height, offset_x, offset_y;
+        stbtt_GetCodepointHMetrics(info, codepoint, &advance, &left_bearing);
+        unsigned char* bitmap = __private_vtxt_glyph_bitmap(info, atlas->font_scale, codepoint,
+                                                            &width, &height, &offset_x, &offset_y);
+
+        // Bottom row first, like the font atlas. The glyph is only published once it's all written.
+        for(int row = 0; row < height; ++row)
+        {
+            memcpy(atlas->atlas.pixels + (size_t) (atlas_y + row) * (size_t) atlas->atlas.width + atlas_x,
+                   bitmap + (size_t) (height - row - 1) * (size_t) width, (size_t) width);
+        }
+        __private_vtxt_free_glyph_bitmap(bitmap);
+        glyph.codepoint = 0;
+        glyph.advance = (float) advance * atlas->font_scale;
+        glyph.width = (float) width;
+        glyph.height = (float) height;
+        glyph.offset_x = (float) offset_x;
+        glyph.offset_y = (float) offset_y;
+        __private_vtxt_publish_glyph(atlas, slot, glyph, atlas_x, atlas_y);
+        __private_vtxt_atomic_store(&atlas->queued[slot], 0);
+        ++inserted;
+
+        vtxt_rect rect = { atlas_x, atlas_y, atlas_x + width, atlas_y + height };
+        if(width > 0 && height > 0)
+        {
+            written = written.x0 < written.x1 ? __private_vtxt_rect_union(written, rect) : rect;
+        }
+    }
+    job->written[task_index] = written;
+    job->inserted[task_index] = inserted;
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_resolve(vtxt_dynamic_atlas* atlas, vtxt_parallel_for_fn parallel_for, void* user_data)
+{
+    // Only the misses whose slot has been written: a thread may have counted a miss but not stored it yet
+    int mask = atlas->capacity - 1;
+    int first = atlas->miss_resolved;
+    int recorded = __private_vtxt_atomic_load(&atlas->miss_count);
+    int end = first;
+    while(end != recorded && __private_vtxt_atomic_load(&atlas->misses[end & mask]) >= 0)
+    {
+        ++end;
+    }
+    __private_vtxt_atomic_add(&atlas->frame, 1);
+    if(end == first)
+    {
+        return 0;
+    }
+
+    _vtxt_miss_job job;
+    int task_count = (end - first + VTXT_MISSES_PER_TASK - 1) / VTXT_MISSES_PER_TASK;
+    job.atlas = atlas;
+    job.first = first;
+    job.end = end;
+    job.written = (vtxt_rect*) malloc(sizeof(vtxt_rect) * (size_t) task_count);
+    job.inserted = (int*) malloc(sizeof(int) * (size_t) task_count);
+    if(parallel_for && task_count > 1)
+    {
+        parallel_for(__private_vtxt_resolve_misses_task, &job, task_count, user_data);
+    }
+    else
+    {
+        for(int task = 0; task < task_count; ++task)
+        {
+            __private_vtxt_resolve_misses_task(&job, task);
+        }
+    }
+
+    int inserted = 0;
+    for(int task = 0; task < task_count; ++task)
+    {
+        inserted += job.inserted[task];
+        if(job.written[task].x0 < job.written[task].x1)
+        {
+            int empty = atlas->dirty.x0 >= atlas->dirty.x1 || atlas->dirty.y0 >= atlas->dirty.y1;
+            atlas->dirty = empty ? job.written[task] : __private_vtxt_rect_union(atlas->dirty, job.written[task]);
+        }
+    }
+    free(job.written);
+    free(job.inserted);
+    for(int miss = first; miss != end; ++miss)
+    {
+        __private_vtxt_atomic_store(&atlas->misses[miss & mask], -1); // ring entry can be reused
+    }
+    atlas->miss_resolved = end;
+    return inserted;
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_grab_dirty(vtxt_dynamic_atlas* atlas, vtxt_rect* rect_out)
+{
+    if(atlas->dirty.x0 >= atlas->dirty.x1 || atlas->dirty.y0 >= atlas->dirty.y1)
+    {
+        return 0;
+    }
+    *rect_out = atlas->dirty;
+    atlas->dirty.x0 = atlas->dirty.y0 = atlas->dirty.x1 = atlas->dirty.y1 = 0;
+    return 1;
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_evict(vtxt_dynamic_atlas* atlas, int max_unused_frames)
+{
+    int evicted = 0;
+    int frame = atlas->frame;
+    for(int slot = 0; slot < atlas->capacity; ++slot)
+    {
+        int state = atlas->ready[slot];
+        if(state > 0 && frame - __private_vtxt_atomic_load(&atlas->last_used[slot]) > max_unused_frames)
+        {
+            // Negative remembers which record was live, so a re-insert writes the other one
+            __private_vtxt_atomic_store(&atlas->ready[slot], -state);
+            ++evicted;
+        }
+    }
+    return evicted;
+}
+
+_vtxt_internal int
+__private_vtxt_compare_long_long(const void* a, const void* b)
+{
+    long long la = *(const long long*) a;
+    long long lb = *(const long long*) b;
+    return (la > lb) - (la < lb);
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_compact_begin(vtxt_dynamic_atlas* atlas)
+{
+    if(atlas->compacting)
+    {
+        return 0;
+    }
+
+    // Live glyphs tallest first, which is what packs shelves tightest
+    long long* order = (long long*) malloc(sizeof(long long) * (size_t) atlas->capacity);
+    int count = 0;
+    for(int slot = 0; slot < atlas->capacity; ++slot)
+    {
+        int state = atlas->ready[slot];
+        if(state > 0)
+        {
+            long long height = (long long) atlas->glyphs[slot * 2 + state - 1].height;
+            order[count++] = -height * atlas->capacity + slot;
+        }
+    }
+    qsort(order, (size_t) count, sizeof(long long), __private_vtxt_compare_long_long);
+    free(atlas->compact_slots);
+    atlas->compact_slots = (int*) malloc(sizeof(int) * (size_t) (count > 0 ? count : 1));
+    for(int i = 0; i < count; ++i)
+    {
+        atlas->compact_slots[i] = (int) (((order[i] % atlas->capacity) + atlas->capacity) % atlas->capacity);
+    }
+    free(order);
+    atlas->compact_count = count;
+    atlas->compact_next = 0;
+
+    // From now on new glyphs go into the fresh texture on the spare page
+    atlas->old_atlas = atlas->atlas;
+    atlas->old_page = atlas->page;
+    atlas->atlas.pixels = (unsigned char*) calloc((size_t) atlas->atlas.width * (size_t) atlas->atlas.height, 1);
+    atlas->page = atlas->spare_page;
+    atlas->spare_page = atlas->old_page;
+    atlas->shelf = 0;
+    atlas->full = 0;
+    atlas->dirty.x0 = atlas->dirty.y0 = atlas->dirty.x1 = atlas->dirty.y1 = 0;
+    atlas->compacting = 1;
+    return 1;
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_compact_step(vtxt_dynamic_atlas* atlas, int max_glyphs, vtxt_atlas_copy* copies_out)
+{
+    if(!atlas->compacting)
+    {
+        return 0;
+    }
+    int copy_count = 0;
+    while(atlas->compact_next < atlas->compact_count && copy_count < max_glyphs)
+    {
+        int slot = atlas->compact_slots[atlas->compact_next++];
+        int state = atlas->ready[slot];
+        if(state <= 0 || atlas->glyph_pages[slot * 2 + state - 1] != atlas->old_page)
+        {
+            continue; // evicted, or evicted and inserted again into the new texture, since begin
+        }
+        vtxt_glyph glyph = atlas->glyphs[slot * 2 + state - 1];
+        int width = (int) glyph.width;
+        int height = (int) glyph.height;
+        int src_x = (int) (glyph.min_u * (float) atlas->old_atlas.width + 0.5f);
+        int src_y = (int) (glyph.min_v * (float) atlas->old_atlas.height + 0.5f);
+        int dst_x, dst_y;
+        if(!__private_vtxt_claim_glyph_rect(atlas, width, height, &dst_x, &dst_y))
+        {
+            atlas->ready[slot] = -state; // the old texture is going away, so it has to be rasterized again
+            atlas->full = 1;
+            continue;
+        }
+        for(int row = 0; row < height; ++row)
+        {
+            memcpy(atlas->atlas.pixels + (size_t) (dst_y + row) * (size_t) atlas->atlas.width + dst_x,
+                   atlas->old_atlas.pixels + (size_t) (src_y + row) * (size_t) atlas->old_atlas.width + src_x, (size_t) width);
+        }
+        __private_vtxt_publish_glyph(atlas, slot, glyph, dst_x, dst_y);
+
+        vtxt_atlas_copy* copy = &copies_out[copy_count++];
+        const vtxt_glyph* moved = &atlas->glyphs[slot * 2 + atlas->ready[slot] - 1];
+        copy->src.x0 = src_x;
+        copy->src.y0 = src_y;
+        copy->src.x1 = src_x + width;
+        copy->src.y1 = src_y + height;
+        copy->dst.x0 = dst_x;
+        copy->dst.y0 = dst_y;
+        copy->dst.x1 = dst_x + width;
+        copy->dst.y1 = dst_y + height;
+        copy->old_uv[0] = glyph.min_u;
+        copy->old_uv[1] = glyph.min_v;
+        copy->old_uv[2] = glyph.max_u;
+        copy->old_uv[3] = glyph.max_v;
+        copy->new_uv[0] = moved->min_u;
+        copy->new_uv[1] = moved->min_v;
+        copy->new_uv[2] = moved->max_u;
+        copy->new_uv[3] = moved->max_v;
+    }
+
+    if(atlas->compact_next == atlas->compact_count)
+    {
+        free(atlas->old_atlas.pixels);
+        atlas->old_atlas.pixels = NULL;
+        free(atlas->compact_slots);
+        atlas->compact_slots = NULL;
+        atlas->compacting = 0;
+    }
+    return copy_count;
+}
+
+/** One corner of a glyph's uv rect before and after a move, sorted by the old corner's bits. */
+typedef struct _vtxt_uv_remap
+{
+    unsigned long long  old_corner;
+    float               new_u;
+    float               new_v;
+} _vtxt_uv_remap;
+
+_vtxt_internal unsigned long long
+__private_vtxt_uv_key(float u, float v)
+{
+    unsigned int bits_u, bits_v;
+    memcpy(&bits_u, &u, sizeof(bits_u));
+    memcpy(&bits_v, &v, sizeof(bits_v));
+    return ((unsigned long long) bits_u << 32) | bits_v;
+}
+
+_vtxt_internal int
+__private_vtxt_compare_uv_remaps(const void* a, const void* b)
+{
+    unsigned long long ka = ((const _vtxt_uv_remap*) a)->old_corner;
+    unsigned long long kb = ((const _vtxt_uv_remap*) b)->old_corner;
+    return (ka > kb) - (ka < kb);
+}
+
+VTXT_DEF void
+vtxt_dynamic_atlas_remap(const vtxt_atlas_copy* copies, int copy_count, float* vertices, int vertex_count)
+{
+    // Every vertex sits exactly on a corner of its glyph's uv rect, and glyph rects are padded apart,
+    // so a vertex's (u, v) bits identify its glyph corner.
+    _vtxt_uv_remap* remaps = (_vtxt_uv_remap*) malloc(sizeof(_vtxt_uv_remap) * 4 * (size_t) (copy_count > 0 ? copy_count : 1));
+    for(int i = 0; i < copy_count; ++i)
+    {
+        for(int corner = 0; corner < 4; ++corner)
+        {
+            int u = corner & 1 ? 2 : 0;
+            int v = corner & 2 ? 3 : 1;
+            remaps[i * 4 + corner].old_corner = __private_vtxt_uv_key(copies[i].old_uv[u], copies[i].old_uv[v]);
+            remaps[i * 4 + corner].new_u = copies[i].new_uv[u];
+            remaps[i * 4 + corner].new_v = copies[i].new_uv[v];
+        }
+    }
+    qsort(remaps, (size_t) copy_count * 4, sizeof(_vtxt_uv_remap), __private_vtxt_compare_uv_remaps);
+
+    for(int i = 0; i < vertex_count; ++i)
+    {
+        unsigned long long key = __private_vtxt_uv_key(vertices[i * 4 + 2], vertices[i * 4 + 3]);
+        int lo = 0;
+        int hi = copy_count * 4;
+        while(lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if(remaps[mid].old_corner < key)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        if(lo < copy_count * 4 && remaps[lo].old_corner == key)
+        {
+            vertices[i * 4 + 2] = remaps[lo].new_u;
+            vertices[i * 4 + 3] = remaps[lo].new_v;
+        }
+    }
+    free(remaps);
+}
+
+/** Codepoint frequency counts of vtxt_dynamic_atlas_prewarm, open addressing on codepoint + 1. */
+typedef struct _vtxt_codepoint_counts
+{
+    int*    keys;
+    int*    counts;
+    int     capacity;
+    int     count;
+} _vtxt_codepoint_counts;
+
+_vtxt_internal void
+__private_vtxt_count_codepoint(_vtxt_codepoint_counts* table, int codepoint)
+{
+    if(2 * (table->count + 1) > table->capacity)
+    {
+        _vtxt_codepoint_counts grown;
+        grown.capacity = table->capacity * 2;
+        grown.count = 0;
+        grown.keys = (int*) calloc((size_t) grown.capacity, sizeof(int));
+        grown.counts = (int*) calloc((size_t) grown.capacity, sizeof(int));
+        for(int i = 0; i < table->capacity; ++i)
+        {
+            if(table->keys[i])
+            {
+                int mask = grown.capacity - 1;
+                int slot = (int) (((unsigned int) (table->keys[i] - 1) * 2654435761u) >> 8) & mask;
+                while(grown.keys[slot])
+                {
+                    slot = (slot + 1) & mask;
+                }
+                grown.keys[slot] = table->keys[i];
+                grown.counts[slot] = table->counts[i];
+                ++grown.count;
+            }
+        }
+        free(table->keys);
+        free(table->counts);
+        *table = grown;
+    }
+    int mask = table->capacity - 1;
+    int slot = (int) (((unsigned int) codepoint * 2654435761u) >> 8) & mask;
+    while(table->keys[slot] && table->keys[slot] != codepoint + 1)
+    {
+        slot = (slot + 1) & mask;
+    }
+    if(!table->keys[slot])
+    {
+        table->keys[slot] = codepoint + 1;
+        ++table->count;
+    }
+    ++table->counts[slot];
+}
+
+/** Counts the non-ASCII codepoints of text[0, size). ASCII comes from the vtxt_font, so runs of it (most of
+    any Latin script table, and all of its markup and ids) are skipped 16 bytes at a time. */
+_vtxt_internal void
+__private_vtxt_count_table_codepoints(_vtxt_codepoint_counts* table, const char* text, size_t size)
+{
+    const unsigned char* s = (const unsigned char*) text;
+    size_t i = 0;
+    while(i < size)
+    {
+#ifdef VTXT_SSE2
+        if(i + 16 <= size && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (s + i))) == 0)
+        {
+            i += 16;
+            continue;
+        }
+#endif
+        if(s[i] < 0x80)
+        {
+            ++i;
+            continue;
+        }
+
+        // The decoder stops at a 0 byte, so a sequence cut off by the end of the table gets a padded copy
+        char tail[5] = { 0, 0, 0, 0, 0 };
+        const char* next = (const char*) s + i;
+        if(size - i < 4)
+        {
+            memcpy(tail, s + i, size - i);
+            next = tail;
+        }
+        const char* start = next;
+        int codepoint = __private_vtxt_decode_utf8(&next);
+        i += (size_t) (next - start);
+        __private_vtxt_count_codepoint(table, codepoint);
+    }
+}
+
+VTXT_DEF int
+vtxt_dynamic_atlas_prewarm(vtxt_dynamic_atlas* atlas, const char* const* tables, const size_t* table_sizes,
+                           int table_count, vtxt_parallel_for_fn parallel_for, void* user_data)
+{
+    _vtxt_codepoint_counts table;
+    table.capacity = 256;
+    table.count = 0;
+    table.keys = (int*) calloc((size_t) table.capacity, sizeof(int));
+    table.counts = (int*) calloc((size_t) table.capacity, sizeof(int));
+    for(int t = 0; t < table_count; ++t)
+    {
+        __private_vtxt_count_table_codepoints(&table, tables[t], table_sizes[t]);
+    }
+
+    // Most frequent first (then by codepoint, so the order doesn't depend on the hash): misses are
+    // rasterized in the order they're requested, so if the atlas fills up it's the rare glyphs left out.
+    long long* order = (long long*) malloc(sizeof(long long) * (size_t) (table.count > 0 ? table.count : 1));
+    int unique = 0;
+    for(int i = 0; i < table.capacity; ++i)
+    {
+        if(table.keys[i])
+        {
+            order[unique++] = ((long long) (0x7FFFFFFF - table.counts[i]) << 21) | (long long) (table.keys[i] - 1);
+        }
+    }
+    free(table.keys);
+    free(table.counts);
+    qsort(order, (size_t) unique, sizeof(long long), __private_vtxt_compare_long_long);
+    for(int i = 0; i < unique; ++i)
+    {
+        int page;
+        vtxt_dynamic_atlas_glyph(atlas, (int) (order[i] & 0x1FFFFF), &page);
+    }
+    free(order);
+    return vtxt_dynamic_atlas_resolve(atlas, parallel_for, user_data);
+}
+
+#ifndef VTXT_NO_STDIO
+
+VTXT_DEF int
+vtxt_dynamic_atlas_prewarm_files(vtxt_dynamic_atlas* atlas, const char* const* file_paths, int file_count,
+                                 vtxt_parallel_for_fn parallel_for, void* user_data)
+{
+    char** tables = (char**) calloc((size_t) (file_count > 0 ? file_count : 1), sizeof(char*));
+    size_t* table_sizes = (size_t*) calloc((size_t) (file_count > 0 ? file_count : 1), sizeof(size_t));
+    for(int f = 0; f < file_count; ++f)
+    {
+        FILE* file = fopen(file_paths[f], "rb");
+        if(file == NULL)
+        {
+            continue; // a missing table just doesn't get prewarmed
+        }
+        fseek(file, 0, SEEK_END);
+        long file_size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        tables[f] = file_size > 0 ? (char*) malloc((size_t) file_size) : NULL;
+        if(tables[f])
+        {
+            table_sizes[f] = fread(tables[f], 1, (size_t) file_size, file);
+        }
+        fclose(file);
+    }
+    int inserted = vtxt_dynamic_atlas_prewarm(atlas, (const char* const*) tables, table_sizes, file_count,
+                                              parallel_for, user_data);
+    for(int f = 0; f < file_count; ++f)
+    {
+        free(tables[f]);
+    }
+    free(tables);
+    free(table_sizes);
+    return inserted;
+}
+
+#endif // VTXT_NO_STDIO
+
+VTXT_DEF void
+vtxt_append_line_utf8(const char* text, vtxt_font* font, vtxt_dynamic_atlas* atlas, int text_height_px)
+{
+    __private_vtxt_damage_begin();
+    int line_start_x = _vtxt_cursor_x;
+    float scale = (float) text_height_px / (float) atlas->font_height_px;
+    while(*text != '\0')
+    {
+        if((unsigned char) *text < 0x80)
+        {
+            // ASCII comes from the font, like vtxt_append_line
+            if(*text == '\t')
+            {
+                __private_vtxt_tab(line_start_x, font, text_height_px);
+            }
+            else if(*text == '\n')
+            {
+                vtxt_new_line(line_start_x, font, text_height_px);
+            }
+            else
+            {
+                if(!__private_vtxt_has_room_for_quad())
+                {
+                    break;
+                }
+                vtxt_append_glyph(*text, font, text_height_px);
+            }
+            ++text;
+            continue;
+        }
+
+        int codepoint = __private_vtxt_decode_utf8(&text);
+        if(!__private_vtxt_has_room_for_quad())
+        {
+            break;
+        }
+        int page;
+        const vtxt_glyph* cached = vtxt_dynamic_atlas_glyph(atlas, codepoint, &page);
+        if(cached)
+        {
+            vtxt_glyph glyph = *cached;
+            glyph.advance *= scale;
+            glyph.width *= scale;
+            glyph.height *= scale;
+            glyph.offset_x *= scale;
+            glyph.offset_y *= scale;
+            __private_vtxt_emit_glyph(glyph, (float) _vtxt_cursor_x, (float) _vtxt_cursor_y, page);
+            _vtxt_cursor_x += (int) glyph.advance;
+        }
+        else
+        {
+            // Not rasterized yet: leave a gap as wide as the glyph, so nothing moves once it arrives
+            int advance, left_bearing;
+            stbtt_GetCodepointHMetrics((const stbtt_fontinfo*) atlas->font_info, codepoint, &advance, &left_bearing);
+            _vtxt_cursor_x += (int) ((float) advance * atlas->font_scale * scale);
+        }
+    }
+    __private_vtxt_damage_end();
+}
+
+VTXT_DEF vtxt_vertex_buffer
+vtxt_grab_buffer()
+{
+    __private_vtxt_flush_stores();
+    vtxt_vertex_buffer retval;
+    retval.vertex_buffer = (float*) _vtxt_vertex_output;
+    retval.vertex_stride = _vtxt_layout.stride;
+    retval.vertices_array_count = _vtxt_vertex_count * 4;
+    if(_vtxt_config & VTXT_CREATE_INDEX_BUFFER)
+    {
+        retval.index_buffer = _vtxt_index_buffer;
+        retval.indices_array_count = _vtxt_index_count;
+    }
+    else
+    {
+        retval.index_buffer = NULL;
+        retval.indices_array_count = 0;
+    }
+    if(_vtxt_config & VTXT_CREATE_COLOR_BUFFER)
+    {
+        retval.color_buffer = _vtxt_color_buffer;
+        retval.colors_array_count = _vtxt_vertex_count;
+    }
+    else
+    {
+        retval.color_buffer = NULL;
+        retval.colors_array_count = 0;
+    }
+    if(!_vtxt_layout_is_default)
+    {
+        retval.vertices_array_count = _vtxt_vertex_count * _vtxt_layout.stride / (int) sizeof(float);
+    }
+    retval.vertex_count = _vtxt_vertex_count;
+    return retval;
+}
+
+VTXT_DEF void
+vtxt_clear_buffer()
+{
+    // No need to actually clear the vertex and index buffers back to 0
+    // Setting the counts back to 0 will suffice
+    _vtxt_vertex_count = 0;
+    _vtxt_index_count = 0;
+#ifdef VTXT_SSE2
+    _vtxt_stream.line_dst = NULL; // a gathered line is of vertices that were just cleared
+    _vtxt_stream.line_mask = 0;
+#endif
+}
+
+// clean up
+#undef VTXT_DEF
+#undef _vtxt_internal
+#undef VTXT_ASCII_FROM
+#undef VTXT_ASCII_TO
+#undef VTXT_MAX_CHAR_IN_BUFFER
+#undef VTXT_GLYPH_COUNT
+#undef VTXT_NOTDEF_GLYPH
+#undef VTXT_MAX_FONT_RESOLUTION
+#undef VTXT_DESIRED_ATLAS_WIDTH
+#undef VTXT_ATLAS_PAD_X
+#undef VTXT_ATLAS_PAD_Y
+#undef VTXT_ATLAS_PACKER_VERSION
+#undef VTXT_MAX_TAB_STOPS
+#undef VTXT_MAX_FONT_TABLES
+#undef VTXT_MAX_FONT_FILE_SIZE
+#undef VTXT_MAX_TABLE_COLUMNS
+#undef VTXT_MAX_DAMAGE_BLOCKS
+#undef VTXT_BLIT_TILE_ROWS
+#undef VTXT_LAYOUT_SLICE
+#undef VTXT_MISSES_PER_TASK
+#undef VTXT_LINE_CHUNK_BYTES
+#undef VTXT_MAX_HYPHEN_WORD
+#undef VTXT_HYPHEN_MEMO_SLOTS
+#undef VTXT_FONT_FILE_MAGIC
+#undef VTXT_FONT_FILE_VERSION
+#undef VTXT_SOLID_BLOCK
+#undef VTXT_STRING_TABLE_MAGIC
+#undef VTXT_STRING_TABLE_VERSION
+#undef VTXT_RASTERIZER_ID
+
+#undef VERTEXT_IMPLEMENTATION
+#endif // VERTEXT_IMPLEMENTATION